@@ -1,5 +1,6 @@
 QT       += core gui
 QT       += charts
+QT       += concurrent
 
 QMAKE_CXXFLAGS_RELEASE = $$QMAKE_CFLAGS_RELEASE_WITH_DEBUGINFO
 QMAKE_CFLAGS_RELEASE = $$QMAKE_LFLAGS_RELEASE_WITH_DEBUGINFO
@@ -15,7 +16,9 @@ CONFIG += c++11
 
 SOURCES += \
     src/AgentController.cpp \
+    src/BusinessLedger.cpp \
     src/ChartHelpers.cpp \
+    src/Currency.cpp \
     src/DualAgent.cpp \
     src/DualController.cpp \
     src/DualLocation.cpp \
@@ -24,6 +27,8 @@ SOURCES += \
     src/EconomicController.cpp \
     src/EconomicLocation.cpp \
     src/EconomicSimulation.cpp \
+    src/EnsembleExecution.cpp \
+    src/EventLog.cpp \
     src/Network.cpp \
     src/PandemicAgent.cpp \
     src/PandemicController.cpp \
@@ -43,6 +48,8 @@ SOURCES += \
 
 HEADERS += \
     Headers/AgentController.h \
+    Headers/BusinessLedger.h \
+    Headers/Currency.h \
     Headers/DualAgent.h \
     Headers/DualController.h \
     Headers/DualLocation.h \
@@ -51,6 +58,8 @@ HEADERS += \
     Headers/EconomicController.h \
     Headers/EconomicLocation.h \
     Headers/EconomicSimulation.h \
+    Headers/EnsembleExecution.h \
+    Headers/EventLog.h \
     Headers/Network.h \
     Headers/PandemicAgent.h \
     Headers/PandemicController.h \
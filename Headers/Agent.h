@@ -6,6 +6,10 @@
 
 #include "Headers/Coordinate.h"
 #include "Headers/Location.h"
+#include "Headers/EventLog.h"
+
+// Forward declaration
+class Simulation;
 
 /**
  * @brief The Agent Class \n
@@ -19,6 +23,9 @@ private:
     /** The current location of the Agent as a Coordinate*/
     Coordinate position;
 
+    /** Unique ID associated with this Agent */
+    int id;
+
     /** The current age of the Agent as an Integer */
     int age;
 
@@ -42,6 +49,15 @@ private:
     /** QString that stored the current destination assignment as a string */
     QString destinationString;
 
+    /** ID of the Location the agent is physically heading toward. Can differ
+    from the Location named by destinationString when working from home. Kept
+    as an ID because the Location can close while the agent is on its way */
+    int destinationID;
+
+    /** Pointer to the Simulation this Agent belongs to. Used to record
+    changes that require the Agent to be redrawn */
+    Simulation* sim;
+
     /** Int representing how wide the agents should be rendered as */
     static const int AGENT_WIDTH = 2;
 
@@ -93,6 +109,13 @@ public:
      */
     void takeTimeStep();
 
+    /**
+     * @brief arriveAtDestination \n
+     * Places the Agent directly at its destination without walking there.
+     * Used when the Simulation skips ahead without moving Agents frame by frame
+     */
+    void arriveAtDestination();
+
     /**
      * @brief setDestination \n
      * Sets the destination of this Agent to the new Location specified
@@ -110,6 +133,15 @@ public:
      */
     QString getDestinationString();
 
+    /**
+     * @brief getDestinationID \n
+     * Getter function for the ID of the Location the Agent is physically
+     * heading toward. IDs are never reused, so the ID stays safe to compare
+     * after the Location closes.
+     * @return the ID of the Location of the Agent's current destination
+     */
+    int getDestinationID();
+
     /**
      * @brief setLocation \n
      * Function to set the value of an Agents assigned location to a new value
@@ -117,7 +149,7 @@ public:
      * @param which: specifies which of the Agent's locations to overwrite
      * (Home, School, Leisure, Work)
      */
-    void setLocation(Location* location, LOCATIONS which);
+    virtual void setLocation(Location* location, LOCATIONS which);
 
     /**
      * @brief getLocation \n
@@ -180,6 +212,13 @@ public:
      */
     int incrementAge();
 
+    /**
+     * @brief getID \n
+     * Getter function for the unique ID associated with this Agent
+     * @return the ID as an int
+     */
+    int getID();
+
     /**
      * @brief setColor \n
      * Setter function for the color of the Agent. Updates the color of the Agent
@@ -188,6 +227,31 @@ public:
      */
     void setColor(QColor color);
 
+    /**
+     * @brief setSimulation \n
+     * Setter function for the Simulation that owns this Agent. Should be
+     * called once the Agent has been added to a Simulation.
+     * @param sim: pointer to the owning Simulation
+     */
+    void setSimulation(Simulation* sim);
+
+    /**
+     * @brief markDirty \n
+     * Records that the rendered color of this Agent may have changed. Only
+     * Agents that have been marked dirty are recolored on the next frame.
+     */
+    void markDirty();
+
+    /**
+     * @brief logEvent \n
+     * Records an event involving this Agent in the Simulation's event log.
+     * Does nothing if the Agent does not belong to a Simulation.
+     * @param type: the kind of event
+     * @param locationID: ID of the Location involved, or -1
+     * @param amount: economic value involved, in Currency units
+     */
+    void logEvent(EventLog::TYPE type, int locationID = -1, long long amount = 0);
+
     /**
      * @brief ~Agent \n
      * Destructor to free memory from the Agent class
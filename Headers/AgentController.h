@@ -71,6 +71,23 @@ private:
     QJsonValue readAssignmentFromJSON(int behaviorChart, int hour,
                                             bool isAdult);
 
+protected:
+
+    /** Number of independent rolls each Agent can draw from a seed */
+    static constexpr unsigned int ROLL_STREAMS = 8;
+
+    /**
+     * @brief getRandomRoll \n
+     * Returns a non-negative random roll that depends only on the seed, the
+     * index of the Agent, and the stream. Lets each Agent draw its own rolls
+     * regardless of which thread evaluates it.
+     * @param seed: the seed drawn for the current hour
+     * @param index: the index of the Agent rolling
+     * @param stream: which of the Agent's rolls to return, below ROLL_STREAMS
+     * @return a non-negative random int
+     */
+    static int getRandomRoll(unsigned long long seed, size_t index, unsigned int stream);
+
 public:
     /**
      * @brief AgentController \n
@@ -177,13 +194,37 @@ public:
      */
     virtual Simulation* getSim();
 
+    /**
+     * @brief removeAgent \n
+     * Releases anything the Controller holds for an Agent that is about to be
+     * deleted. Called by Simulation::killAgent before the Agent is freed.
+     * @param victim: pointer to the Agent being removed
+     */
+    virtual void removeAgent(Agent* victim);
+
+    /**
+     * @brief locationChanged \n
+     * Notifies the Controller that the occupancy or state of a Location has
+     * changed. Called by Location::markChanged.
+     * @param location: pointer to the Location that changed
+     */
+    virtual void locationChanged(Location* location);
+
+    /**
+     * @brief removeLocation \n
+     * Releases anything the Controller holds for a Location that is about to
+     * be deleted. Called by Region::removeLocation before the Location is freed.
+     * @param victim: pointer to the Location being removed
+     */
+    virtual void removeLocation(Location* victim);
+
     /**
      * @brief sampleAgentAge \n
      * Generates a new random age for an agent that is sampled from the standard
      * age distribution of the United States.
      * @return the randomly sampled age as an integer
      */
-    static int sampleAgentAge();
+    int sampleAgentAge();
 
     /** Virtual Destructor of the AgentController class */
     virtual ~AgentController();
@@ -0,0 +1,289 @@
+#ifndef BUSINESSLEDGER_H
+#define BUSINESSLEDGER_H
+
+#include <vector>
+#include <algorithm>
+
+#include "Currency.h"
+
+// Forward Declarations
+class EconomicLocation;
+
+
+/**
+ * @brief The BusinessLedger class \n
+ * Class that holds the economic state of every open business in contiguous
+ * arrays, one array per field. Work Locations registered with the ledger read
+ * and write their value through it, which lets the hourly business update
+ * apply overhead, roll over the day, and total the value of every business
+ * in a single pass over each array.
+ *
+ * Value shared equally between businesses is not written to each of them.
+ * Instead, the ledger adds each business's share to a running dividend, and a
+ * business's value is its stored value plus the dividend paid out since it
+ * was last settled. Distributing value is then a single addition, no matter
+ * how many businesses are open.
+ *
+ * The ledger also keeps a pool of the businesses that can hire today, so job
+ * seekers can be matched with an open vacancy without probing every business.
+ */
+class BusinessLedger {
+
+private:
+
+    /** The Work Location that owns each entry */
+    std::vector<EconomicLocation*> locations;
+
+    /** The current economic value of each business */
+    std::vector<Currency> values;
+
+    /** The cost of working at each business */
+    std::vector<double> costs;
+
+    /** How much the value of each business has changed by today */
+    std::vector<Currency> dailyValueChanges;
+
+    /** How much the value of each business changed by yesterday */
+    std::vector<Currency> yesterdayValueChanges;
+
+    /** The number of days each business has been open */
+    std::vector<int> daysOpen;
+
+    /** Whether each business has hired an Agent today */
+    std::vector<char> dailyHires;
+
+    /** The running dividend when each business was last settled */
+    std::vector<Currency> dividendsAtEntry;
+
+    /** Whether each business currently receives distributed value */
+    std::vector<char> shareholders;
+
+    /** The position of each business in the vacancies pool, or -1 */
+    std::vector<int> vacancySlots;
+
+    /** Index of every business that is able to hire an Agent today */
+    std::vector<int> vacancies;
+
+    /** Total value distributed to each shareholding business so far */
+    Currency dividendPerShare;
+
+    /** Value left over from rounding the last share, paid out with the next */
+    Currency undistributed;
+
+    /** The number of businesses that currently receive distributed value */
+    int numShareholders;
+
+    /**
+     * @brief getPendingDividend \n
+     * Returns the distributed value a business is owed but has not yet
+     * added to its stored value
+     * @param index: the index of the business
+     * @return the value owed to the business
+     */
+    Currency getPendingDividend(int index);
+
+    /**
+     * @brief settle \n
+     * Adds the value owed to a business into its stored value and daily value
+     * change. Must be called before any update that reads or clamps the
+     * stored value.
+     * @param index: the index of the business
+     */
+    void settle(int index);
+
+    /**
+     * @brief canHire \n
+     * Determines whether a business is able to hire today. A business can
+     * hire once a day if its value grew by more than twice its cost yesterday.
+     * @param index: the index of the business
+     * @return whether the business can hire
+     */
+    bool canHire(int index);
+
+    /**
+     * @brief updateVacancy \n
+     * Adds a business to the vacancies pool if it is able to hire today, or
+     * removes it if it is not
+     * @param index: the index of the business
+     */
+    void updateVacancy(int index);
+
+    /**
+     * @brief removeVacancy \n
+     * Removes a business from the vacancies pool if it is in it. The last
+     * vacancy is moved into its slot.
+     * @param index: the index of the business
+     */
+    void removeVacancy(int index);
+
+    /**
+     * @brief refreshValueBuckets \n
+     * Updates the value bucket of every business after a pass that changed
+     * their values
+     */
+    void refreshValueBuckets();
+
+public:
+
+    /**
+     * @brief BusinessLedger \n
+     * Constructor for an empty BusinessLedger
+     */
+    BusinessLedger();
+
+    /**
+     * @brief addBusiness \n
+     * Moves the economic state of a Work Location into the ledger. From then
+     * on, the Location reads and writes its state through the ledger.
+     * @param location: the Work Location to add
+     */
+    void addBusiness(EconomicLocation* location);
+
+    /**
+     * @brief removeBusiness \n
+     * Moves the economic state of a business back into its Location and
+     * removes it from the ledger. The last entry is moved into its slot.
+     * @param location: the Work Location to remove
+     */
+    void removeBusiness(EconomicLocation* location);
+
+    /**
+     * @brief size \n
+     * Getter function for the number of businesses in the ledger
+     * @return the number of businesses as an int
+     */
+    int size();
+
+    /**
+     * @brief getLocation \n
+     * Getter function for the Work Location that owns an entry
+     * @param index: the index of the entry
+     * @return a pointer to the Work Location
+     */
+    EconomicLocation* getLocation(int index);
+
+    /**
+     * @brief getValue \n
+     * Getter function for the value of a business
+     * @param index: the index of the business
+     * @return the value of the business
+     */
+    Currency getValue(int index);
+
+    /**
+     * @brief incrementValue \n
+     * Increments the value of a business. Will not allow the value to go below
+     * zero.
+     * @param index: the index of the business
+     * @param amount: the amount to increment the value by
+     * @return the new value of the business
+     */
+    Currency incrementValue(int index, Currency amount);
+
+    /**
+     * @brief getCost \n
+     * Getter function for the cost of a business
+     * @param index: the index of the business
+     * @return the cost of the business
+     */
+    double getCost(int index);
+
+    /**
+     * @brief getYesterdayValueChange \n
+     * Getter function for the value change of a business yesterday
+     * @param index: the index of the business
+     * @return the value change of the business yesterday
+     */
+    Currency getYesterdayValueChange(int index);
+
+    /**
+     * @brief getDaysOpen \n
+     * Getter function for the number of days a business has been open
+     * @param index: the index of the business
+     * @return the number of days open as an int
+     */
+    int getDaysOpen(int index);
+
+    /**
+     * @brief makeHire \n
+     * Determines whether a business is able to hire a new Agent today
+     * @param index: the index of the business
+     * @return whether the business can hire a new Agent
+     */
+    bool makeHire(int index);
+
+    /**
+     * @brief getNumVacancies \n
+     * Getter function for the number of businesses that are able to hire today
+     * @return the number of vacancies as an int
+     */
+    int getNumVacancies();
+
+    /**
+     * @brief getVacancy \n
+     * Getter function for a business that is able to hire today. The order of
+     * the vacancies changes whenever a business hires, opens or closes.
+     * @param slot: the position in the vacancies pool
+     * @return a pointer to the Work Location of the business
+     */
+    EconomicLocation* getVacancy(int slot);
+
+    /**
+     * @brief setShareholder \n
+     * Sets whether a business receives its share of distributed value. Value
+     * distributed before the change is settled under the old status.
+     * @param index: the index of the business
+     * @param shareholder: whether the business should receive distributed value
+     */
+    void setShareholder(int index, bool shareholder);
+
+    /**
+     * @brief distribute \n
+     * Shares an amount of value equally between every shareholding business.
+     * The value is paid through a running dividend, and each business's value
+     * bucket is refreshed afterwards so readers never need to settle it
+     * @param amount: the total value to distribute
+     * @return false if there were no shareholders to receive the value
+     */
+    bool distribute(Currency amount);
+
+    /**
+     * @brief getNumShareholders \n
+     * Getter function for the number of businesses receiving distributed value
+     * @return the number of shareholders as an int
+     */
+    int getNumShareholders();
+
+    /**
+     * @brief startNewDay \n
+     * Rolls the daily value change of every business over to yesterday, resets
+     * the daily hires, counts another day open for every business, and
+     * rebuilds the vacancies pool
+     */
+    void startNewDay();
+
+    /**
+     * @brief applyOverhead \n
+     * Has every business pay a fixed overhead. Values will not go below zero.
+     * @param amount: the overhead each business pays
+     */
+    void applyOverhead(Currency amount);
+
+    /**
+     * @brief getTotalValue \n
+     * Returns the total value held by every business in the ledger
+     * @return the total value as Currency
+     */
+    Currency getTotalValue();
+
+    /**
+     * @brief getBankruptcyCandidates \n
+     * Collects every business that has run out of value. The businesses are
+     * not removed, so the caller can decide which of them go bankrupt.
+     * @return the Work Location of every business with no value
+     */
+    std::vector<EconomicLocation*> getBankruptcyCandidates();
+
+};
+
+#endif // BUSINESSLEDGER_H
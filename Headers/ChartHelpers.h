@@ -2,16 +2,66 @@
 #define CHARTHELPERS_H
 
 #include <unordered_map>
+#include <atomic>
 
 #include "QChart"
 #include "QBarSet"
 #include "QBarSeries"
 #include "QBarCategoryAxis"
+#include "QLineSeries"
 
 #include "Agent.h"
 #include "Location.h"
 
 
+/**
+ * @brief The SimulationStats struct
+ * Compact summary of the Simulation's state that is filled in a single pass
+ * over the Agents on the worker thread. Every bar chart helper reads its
+ * counts from this struct instead of scanning the Agents itself.
+ */
+struct SimulationStats {
+
+    /** Number of buckets in the age and value distributions */
+    static constexpr int NUM_AGE_BUCKETS = 10;
+    static constexpr int NUM_VALUE_BUCKETS = 5;
+
+    /** Number of Agents in each ten year age bucket */
+    std::vector<int> ageCounts;
+
+    /** Number of Adults and Children assigned to each behavior chart */
+    std::vector<int> adultBehaviorCounts;
+    std::vector<int> childBehaviorCounts;
+
+    /** Number of Agents heading to each destination, indexed by Agent::LOCATIONS */
+    std::vector<int> destinationCounts;
+
+    /** Number of Agents and businesses in each value bucket */
+    std::vector<int> agentValueCounts;
+    std::vector<int> businessValueCounts;
+
+    /** Number of Agents in each Pandemic status, indexed by PandemicAgent::STATUS */
+    std::vector<int> SEIRCounts;
+
+    /** Number of Agents that are homeless, unemployed, and alive */
+    int numHomeless;
+    int numUnemployed;
+    int numAgents;
+
+    /**
+     * @brief SimulationStats \n
+     * Constructor for the SimulationStats struct. Sizes each count vector and
+     * sets every count to zero.
+     * @param numAdultBehaviors: number of unique Adult Behaviors
+     * @param numChildBehaviors: number of unique Child Behaviors
+     */
+    SimulationStats(int numAdultBehaviors = 0, int numChildBehaviors = 0);
+};
+
+
+//******************************************************************************
+
+
 /**
  * @brief The AgeChartHelper class
  * Helper class that handles dynamic memory for the Age Distribution Graph View.
@@ -76,19 +126,19 @@ public:
      * Returns a current pointer to the AgeChart. If the chart has not been
      * created yet, initialize a new one and return it. Utilized to pass
      * ownership of the chart to a new chartView
-     * @param agents: the current set of agents in the simulation
+     * @param stats: the most recent statistics collected from the simulation
      * @return a QChart* that points to the current AgeChart
      */
-    QtCharts::QChart* getChart(std::vector<Agent*> *agents);
+    QtCharts::QChart* getChart(const SimulationStats &stats);
 
     /**
      * @brief updateChart \n
      * Updates the bars in the AgeChart to reflect the new Age Distribution
      * of the agents. AgeChart must be initialized using getAgeChart() before
      * this function can be called.
-     * @param agents: the current set of agents in the simulation
+     * @param stats: the most recent statistics collected from the simulation
      */
-    void updateChart(std::vector<Agent*> *agents);
+    void updateChart(const SimulationStats &stats);
 
 };
 
@@ -163,23 +213,19 @@ public:
      * QChartView. If a BehaviorGraph view has not yet been initialized,
      * it will initialize one. Otherwise, it will return the existing one that
      * has been updated
-     * @param agents: the current set of agents in the Simulation
-     * @param numAdultBehaviors: number of unique Adult Behaviors
-     * @param numChildBehaviors: number of unique Child Behaviors
+     * @param stats: the most recent statistics collected from the Simulation
      * @return
      */
-    QtCharts::QChart* getChart(std::vector<Agent*> *agents, int numAdultBehaviors, int numChildBehaviors);
+    QtCharts::QChart* getChart(const SimulationStats &stats);
 
     /**
      * @brief updateChart \n
      * Updates the BehaviorGraph view without returning a pointer to it. Causes
      * the QChart rendering to be updated on the screen, in whatever QChartView
      * it has been assigned to
-     * @param agents: the current set of Agents in the Simulation
-     * @param numAdultBehaviors: number of unique Adult Behaviors
-     * @param numChildBehaviors: number of unique Child Behaviors
+     * @param stats: the most recent statistics collected from the Simulation
      */
-    void updateChart(std::vector<Agent*> *agents, int numAdultBehaviors, int numChildBehaviors);
+    void updateChart(const SimulationStats &stats);
 
 
 };
@@ -255,19 +301,19 @@ public:
      * Returns a QChart* pointer to a completed DestinationChart that can
      * be added to a QChartView. Initializes the Chart if one has not been
      * initialized, otherwise updates and returns the existing chart
-     * @param agents: the current set of agents in the Simulation
+     * @param stats: the most recent statistics collected from the Simulation
      * @return
      */
-    QtCharts::QChart* getChart(std::vector<Agent*> *agents);
+    QtCharts::QChart* getChart(const SimulationStats &stats);
 
     /**
      * @brief updateChart \n
      * Updates the DestinationChart to reflect the updated state of the Agents
      * in the Simulation. DestinationChart must be initialized using
      * getDestinationChart first, before this can be called.
-     * @param agents
+     * @param stats: the most recent statistics collected from the Simulation
      */
-    void updateChart(std::vector<Agent*> *agents);
+    void updateChart(const SimulationStats &stats);
 };
 
 
@@ -286,6 +332,77 @@ int roundToNearestHundred(double n);
 //******************************************************************************
 
 
+/**
+ * @brief valueToBucket \n
+ * Determines which of the five value buckets the provided value falls into.
+ * Bucket zero holds values of exactly zero and the last bucket holds every
+ * value above the largest threshold.
+ * @param value: the value to place in a bucket
+ * @param thresholds: the thresholds that separate each bucket
+ * @return the index of the bucket as an int
+ */
+int valueToBucket(int value, const std::vector<int>& thresholds);
+
+
+//******************************************************************************
+
+
+/**
+ * @brief The ValueHistogram class
+ * Running count of the items in each value bucket. Agents and businesses
+ * report whenever their value moves them into a new bucket, so the counts can
+ * be read without visiting every item. Counts are atomic because items move
+ * between buckets during the parallel economic update.
+ */
+class ValueHistogram {
+
+private:
+
+    /** Pointer to the thresholds that separate each bucket */
+    const std::vector<int>* thresholds;
+
+    /** Number of items currently in each bucket */
+    std::atomic<int> counts[SimulationStats::NUM_VALUE_BUCKETS];
+
+public:
+
+    /**
+     * @brief ValueHistogram \n
+     * Constructor for an empty ValueHistogram
+     * @param thresholds: pointer to the thresholds that separate each bucket
+     */
+    ValueHistogram(const std::vector<int>* thresholds);
+
+    /**
+     * @brief getBucket \n
+     * Determines which bucket a value falls into
+     * @param value: the value to place in a bucket
+     * @return the index of the bucket as an int
+     */
+    int getBucket(int value);
+
+    /**
+     * @brief move \n
+     * Moves a single item from one bucket to another. A bucket of -1 adds or
+     * removes the item.
+     * @param from: the bucket the item was in, or -1
+     * @param to: the bucket the item is now in, or -1
+     */
+    void move(int from, int to);
+
+    /**
+     * @brief getCounts \n
+     * Returns the number of items in each bucket
+     * @return a std::vector of the count in each bucket
+     */
+    std::vector<int> getCounts();
+
+};
+
+
+//******************************************************************************
+
+
 /**
  * @brief The AgentValueChartHelper class
  * Helper class that handles dynamic memory for the Agent Value Graph View.
@@ -340,6 +457,9 @@ private:
     /** Vector to track the bucket thresholds */
     std::vector<int> thresholds;
 
+    /** Running count of the Agents in each bucket */
+    ValueHistogram histogram;
+
 public:
 
     /**
@@ -357,19 +477,19 @@ public:
      * Returns a current pointer to the AgentValueChart. If the chart has not been
      * created yet, initialize a new one and return it. Utilized to pass
      * ownership of the chart to a new chartView
-     * @param agents: the current set of agents in the simulation
+     * @param stats: the most recent statistics collected from the simulation
      * @return a QChart* that points to the current AgeChart
      */
-    QtCharts::QChart* getChart(std::vector<Agent*> *agents);
+    QtCharts::QChart* getChart(const SimulationStats &stats);
 
     /**
      * @brief updateAgeChart \n
      * Updates the bars in the AgentValueChart to reflect the new value distribution
      * of the agents. AgentValueChart must be initialized using getChart() before
      * this function can be called.
-     * @param agents: the current set of agents in the simulation
+     * @param stats: the most recent statistics collected from the simulation
      */
-    void updateChart(std::vector<Agent*> *agents);
+    void updateChart(const SimulationStats &stats);
 
     /**
      * @brief getThresholds \n
@@ -380,6 +500,14 @@ public:
      */
     std::vector<int>& getThresholds();
 
+    /**
+     * @brief getHistogram \n
+     * Getter function for the running count of Agents in each bucket. Each
+     * EconomicAgent reports its own moves between buckets.
+     * @return the histogram of Agent values
+     */
+    ValueHistogram& getHistogram();
+
 };
 
 
@@ -440,6 +568,9 @@ private:
     /** Vector to track the bucket thresholds */
     std::vector<int> thresholds;
 
+    /** Running count of the businesses in each bucket */
+    ValueHistogram histogram;
+
 public:
 
     /**
@@ -457,19 +588,19 @@ public:
      * Returns a current pointer to the WorkValueChart. If the chart has not been
      * created yet, initialize a new one and return it. Utilized to pass
      * ownership of the chart to a new chartView
-     * @param agents: the current set of agents in the simulation
+     * @param stats: the most recent statistics collected from the simulation
      * @return a QChart* that points to the current WorkValueChart
      */
-    QtCharts::QChart* getChart(std::vector<Location*> *locations);
+    QtCharts::QChart* getChart(const SimulationStats &stats);
 
     /**
      * @brief updateChart \n
      * Updates the bars in the WorkValue Chart to reflect the new value
      * distribution among work locations. Chart must be initialized using
      * getChart() before this function can be called.
-     * @param locations: the current vector of locations in the simulation
+     * @param stats: the most recent statistics collected from the simulation
      */
-    void updateChart(std::vector<Location*> *locations);
+    void updateChart(const SimulationStats &stats);
 
     /**
      * @brief getThresholds \n
@@ -480,6 +611,146 @@ public:
      */
     std::vector<int>& getThresholds();
 
+    /**
+     * @brief getHistogram \n
+     * Getter function for the running count of businesses in each bucket. Each
+     * Work Location reports its own moves between buckets.
+     * @return the histogram of business values
+     */
+    ValueHistogram& getHistogram();
+
+};
+
+
+//******************************************************************************
+
+
+/**
+ * @brief The TimeSeries class
+ * Helper class that stores every point of a line chart in a compact array and
+ * limits how many of them are drawn. Once the history grows past the point
+ * budget, it is split into buckets of equal width and the
+ * Largest-Triangle-Three-Buckets algorithm keeps one point from each, which
+ * keeps the peaks and troughs of the full history.
+ *
+ * A bucket's point depends on the bucket after it, so it is fixed once that
+ * bucket fills. Each update only re-selects the points of the last two
+ * buckets. When the buckets no longer fit in the budget their width doubles
+ * and every point is selected again, which happens each time the history
+ * doubles.
+ */
+class TimeSeries {
+
+private:
+
+    /** Every value appended to the series, one per Simulation hour */
+    std::vector<float> history;
+
+    /** Maximum number of points drawn in the chart */
+    int pointBudget;
+
+    /** Number of hours in each bucket, or 0 while the full history is drawn */
+    int bucketWidth;
+
+    /** The point kept from each bucket whose point can no longer change */
+    QVector<QPointF> finalized;
+
+    /** Number of finalized points already drawn in the series */
+    int numDrawn;
+
+    /**
+     * @brief getNumBuckets \n
+     * Returns the number of buckets, full or not, between the first and last
+     * points of the history
+     * @return the number of buckets as an int
+     */
+    int getNumBuckets();
+
+    /**
+     * @brief getBucketAverage \n
+     * Averages the points in a bucket. Returns the last point of the history
+     * if the bucket is empty.
+     * @param bucket: the index of the bucket
+     * @return the average point
+     */
+    QPointF getBucketAverage(int bucket);
+
+    /**
+     * @brief selectPoint \n
+     * Selects the point in a bucket that forms the largest triangle with the
+     * point kept before it and the average of the bucket after it
+     * @param bucket: the index of the bucket
+     * @param previous: the point kept from the previous bucket
+     * @param next: the average of the next bucket
+     * @return the selected point
+     */
+    QPointF selectPoint(int bucket, QPointF previous, QPointF next);
+
+    /**
+     * @brief rebucket \n
+     * Doubles the bucket width until every bucket fits in the budget and
+     * selects every finalized point again
+     */
+    void rebucket();
+
+    /**
+     * @brief finalizeBuckets \n
+     * Selects the point of every bucket whose following bucket has filled
+     * since the last call
+     */
+    void finalizeBuckets();
+
+    /**
+     * @brief getTail \n
+     * Selects the points of the buckets that are not finalized yet
+     * @return the points of those buckets, followed by the last point
+     */
+    QList<QPointF> getTail();
+
+public:
+
+    /** Default maximum number of points drawn in the chart */
+    static constexpr int DEFAULT_POINT_BUDGET = 500;
+
+    /**
+     * @brief TimeSeries \n
+     * Constructor for the TimeSeries class. Creates an empty series
+     * @param pointBudget: maximum number of points drawn in the chart
+     */
+    TimeSeries(int pointBudget = DEFAULT_POINT_BUDGET);
+
+    /**
+     * @brief append \n
+     * Adds a new value to the end of the full resolution history
+     * @param value: the value to add
+     */
+    void append(double value);
+
+    /**
+     * @brief size \n
+     * Getter function for the number of values in the full history
+     * @return the number of values as an int
+     */
+    int size();
+
+    /**
+     * @brief getHistory \n
+     * Getter function for the full resolution history of the series. Enables
+     * the series to be exported without the loss from downsampling.
+     * @return a reference to the history
+     */
+    const std::vector<float>& getHistory() const;
+
+    /**
+     * @brief updateSeries \n
+     * Updates the provided QLineSeries to display the latest value. Appends
+     * a single point while the history fits in the budget. Afterwards, only
+     * the points after the last finalized one are replaced, unless the
+     * buckets have just been widened.
+     * @param series: the QLineSeries displaying this TimeSeries
+     */
+    void updateSeries(QtCharts::QLineSeries* series);
+
 };
 
 
@@ -506,6 +777,9 @@ private:
     int maximum;
     int minimum;
 
+    /** Full history of the Total Value line */
+    TimeSeries totalHistory;
+
     /**
      * @brief getNewLineSeries \n
      * Creates a new QLineSeries object if one hasn't been initialized, otherwise
@@ -562,6 +836,13 @@ public:
      */
     void updateChart(int totalValue);
 
+    /**
+     * @brief getHistory \n
+     * Getter function for the full resolution history of the Total Value line
+     * @return a reference to the history
+     */
+    const std::vector<float>& getHistory() const;
+
 };
 
 
@@ -589,6 +870,10 @@ private:
     int maximum;
     int minimum;
 
+    /** Full history of the Unemployment and Homelessness rate lines */
+    TimeSeries unemployedHistory;
+    TimeSeries homelessHistory;
+
     /**
      * @brief getHomelessLineSeries \n
      * Creates a new QLineSeries object if one hasn't been initialized, otherwise
@@ -653,6 +938,14 @@ public:
      */
     void updateChart(double homelessCount, double unemployedCount, int numAgents);
 
+    /**
+     * @brief getHistory \n
+     * Getter function for the full resolution history of one of the lines
+     * @param which: either "Homeless" or "Unemployed"
+     * @return a reference to the history
+     */
+    const std::vector<float>& getHistory(QString which) const;
+
 };
 
 
@@ -683,6 +976,12 @@ private:
     int maximum;
     int minimum;
 
+    /** Full history of each SEIR line */
+    TimeSeries susceptibleHistory;
+    TimeSeries exposedHistory;
+    TimeSeries infectedHistory;
+    TimeSeries recoveredHistory;
+
     /**
      * @brief getLineSeries \n
      * Creates a new QLineSeries object if one hasn't been initialized, otherwise
@@ -742,6 +1041,14 @@ public:
      */
     void updateChart(std::vector<int> SEIRAgents, int numAgents);
 
+    /**
+     * @brief getHistory \n
+     * Getter function for the full resolution history of one of the lines
+     * @param which: "Susceptible", "Exposed", "Infected", or "Recovered"
+     * @return a reference to the history
+     */
+    const std::vector<float>& getHistory(QString which) const;
+
 };
 
 
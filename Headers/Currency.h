@@ -0,0 +1,116 @@
+#ifndef CURRENCY_H
+#define CURRENCY_H
+
+#include <cmath>
+
+
+/**
+ * @brief The Currency class \n
+ * Fixed-point amount of economic value, stored as a 64-bit count of
+ * ten-thousandths of a unit. Adding and subtracting amounts is exact, so
+ * totals don't drift and can be summed in any order or on any number of
+ * threads with the same result. Only scaling and dividing an amount round,
+ * and they always round the same way.
+ */
+class Currency {
+
+private:
+
+    /** The amount in ten-thousandths of a unit */
+    long long units;
+
+public:
+
+    /** Number of stored units in a single unit of value */
+    static constexpr long long UNITS_PER_WHOLE = 10000;
+
+    /**
+     * @brief Currency \n
+     * Constructor for an amount of zero
+     */
+    Currency();
+
+    /**
+     * @brief Currency \n
+     * Constructor for a whole amount of value
+     * @param whole: the amount in whole units
+     */
+    explicit Currency(int whole);
+
+    /**
+     * @brief fromDouble \n
+     * Converts a floating point amount, rounding to the nearest stored unit
+     * @param amount: the amount in whole units
+     * @return the amount as Currency
+     */
+    static Currency fromDouble(double amount);
+
+    /**
+     * @brief fromUnits \n
+     * Creates an amount from a raw count of stored units
+     * @param units: the amount in ten-thousandths of a unit
+     * @return the amount as Currency
+     */
+    static Currency fromUnits(long long units);
+
+    /**
+     * @brief getUnits \n
+     * Getter function for the raw count of stored units
+     * @return the amount in ten-thousandths of a unit
+     */
+    long long getUnits() const;
+
+    /**
+     * @brief toInt \n
+     * Returns the whole part of the amount, truncated towards zero
+     * @return the whole amount as an int
+     */
+    int toInt() const;
+
+    /**
+     * @brief toDouble \n
+     * Returns the amount as a floating point number, for display and charts
+     * @return the amount as a double
+     */
+    double toDouble() const;
+
+    /**
+     * @brief scaledBy \n
+     * Scales the amount by a factor, rounding to the nearest stored unit
+     * @param factor: the factor to scale by
+     * @return the scaled amount
+     */
+    Currency scaledBy(double factor) const;
+
+    /**
+     * @brief multipliedBy \n
+     * Multiplies the amount by a whole number. Exact.
+     * @param count: the number to multiply by
+     * @return the product
+     */
+    Currency multipliedBy(long long count) const;
+
+    /**
+     * @brief dividedBy \n
+     * Splits the amount into equal shares, truncating towards zero. The
+     * remainder can be found with multipliedBy.
+     * @param count: the number of shares, must be positive
+     * @return the amount of a single share
+     */
+    Currency dividedBy(long long count) const;
+
+    Currency operator+(const Currency &other) const;
+    Currency operator-(const Currency &other) const;
+    Currency operator-() const;
+    Currency& operator+=(const Currency &other);
+    Currency& operator-=(const Currency &other);
+    bool operator==(const Currency &other) const;
+    bool operator!=(const Currency &other) const;
+    bool operator<(const Currency &other) const;
+    bool operator>(const Currency &other) const;
+    bool operator<=(const Currency &other) const;
+    bool operator>=(const Currency &other) const;
+
+};
+
+#endif // CURRENCY_H
@@ -17,7 +17,13 @@ class DualController : public PandemicController, public EconomicController {
 private:
 
     /** Economic value to be redistributed when an Agent dies */
-    double agentRedistributedValue;
+    Currency agentRedistributedValue;
+
+    /** Running total of the value paid out to each living Agent */
+    Currency perCapitaPayout;
+
+    /** Value left over from rounding the last payout, paid out with the next */
+    Currency undistributedPayout;
 
 public:
 
@@ -51,11 +57,14 @@ public:
     virtual void updateSingleDestination(Agent* agent, int hour, bool randomAllowed) override;
 
     /**
-     * @brief lockdownLocations \n
-     * Function that will move through every location and lock them down if
-     * necessary, depending on the threshold specified in the UI.
+     * @brief updateLockdownStatus \n
+     * Re-evaluates the Pandemic status of a single Location under the given
+     * lockdown policy. Leisure locations are locked down along with their
+     * sibling business.
+     * @param location: the Location to update
+     * @param policy: the active lockdown policy
      */
-    virtual void lockdownLocations() override;
+    virtual void updateLockdownStatus(PandemicLocation* location, LOCKDOWN policy) override;
 
     /**
      * @brief businessEconomicUpdate \n
@@ -72,9 +81,11 @@ public:
      * agents lose value to various expenses, and some of that value gets given
      * back to businesses. Agents can go homeless while at home.
      * @param agent: agent to be updated
+     * @param index: the index of the agent, used to draw its random rolls
+     * @param shard: the shard collecting changes to shared state
      * @returns value lost by agent that should be distributed to businesses
      */
-    virtual double homeEconomicUpdate(EconomicAgent* agent) override;
+    virtual Currency homeEconomicUpdate(EconomicAgent* agent, size_t index, EconomicShard &shard) override;
 
     /**
      * @brief workEconomicUpdate \n
@@ -82,8 +93,10 @@ public:
      * agents gain value from working, and some of the value gets taken from
      * the business. Businesses can go bankrupt while workers are there
      * @param agent: agent to be updated
+     * @param index: the index of the agent, used to draw its random rolls
+     * @param shard: the shard collecting changes to shared state
      */
-    virtual void workEconomicUpdate(EconomicAgent* agent) override;
+    virtual void workEconomicUpdate(EconomicAgent* agent, size_t index, EconomicShard &shard) override;
 
     /**
      * @brief makeHomeless \n
@@ -93,6 +106,13 @@ public:
      */
     virtual void makeHomeless(EconomicAgent* agent) override;
 
+    /**
+     * @brief removeAgent \n
+     * Releases the dying Agent from both the Pandemic and Economic Controllers
+     * @param victim: pointer to the Agent being removed
+     */
+    virtual void removeAgent(Agent* victim) override;
+
     /**
      * @brief finishEconomicUpdate \n
      * Performs the finishing operations on the Economic update. Enables new
@@ -102,7 +122,16 @@ public:
      * @param redistributedValue: the total amount of value to be distributed to businesses
      * @param type: the type of location for a newly generated business to be
      */
-    virtual void finishEconomicUpdate(double redistributedValue, QString type = "Dual") override;
+    virtual void finishEconomicUpdate(Currency redistributedValue, QString type = "Dual") override;
+
+    /**
+     * @brief getPerCapitaPayout \n
+     * Getter function for the running total paid out to each Agent from the
+     * value of Agents that died. Agents settle their value against it when
+     * read, so paying every Agent only updates the total.
+     * @return a pointer to the running per-capita payout
+     */
+    const Currency* getPerCapitaPayout();
 
 };
 
@@ -9,6 +9,17 @@ class DualLocation : public PandemicLocation, public EconomicLocation {
 
 private:
 
+protected:
+
+    /**
+     * @brief statusChanged \n
+     * Businesses on lockdown don't receive the value redistributed between
+     * businesses, so update the Location's share when it enters or leaves
+     * lockdown
+     * @param previousStatus: the status the Location had before the change
+     */
+    virtual void statusChanged(PandemicLocation::STATUS previousStatus) override;
+
 public:
 
     /**
@@ -19,8 +30,10 @@ public:
      * @param x: the x coordinate of the Location
      * @param y: the y coordinate of the Location
      * @param type: the type of location
+     * @param costRoll: a non-negative random int drawn by the Simulation,
+     * used to pick the cost of Work and Leisure locations
      */
-    DualLocation(double x, double y, Agent::LOCATIONS type);
+    DualLocation(double x, double y, Agent::LOCATIONS type, int costRoll);
 
 };
 
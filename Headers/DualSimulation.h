@@ -30,6 +30,9 @@ private:
     /** Mapping between integer indexes and Policy QCheckBoxes*/
     std::unordered_map<int, QCheckBox*> indexPolicyMapping;
 
+    /** Counter to determine if an hour has passed */
+    int numFrames;
+
 public:
 
     /**
@@ -42,9 +45,12 @@ public:
      * @param numAgents: the initial number of agents in the Simulation
      * @param ui: the MainWindow::ui containing information on all the user inputs
      * @param debug: a map of debug info about the Simulation
+     * @param network: the network that chooses the policies, or nullptr
+     * @param settings: the settings to use if ui is nullptr
      */
     DualSimulation(int lagPeriod, int initialInfected, int initialValue, int numAgents, Ui::MainWindow* ui,
-                       std::map<std::string, bool> debug, PolicyNetwork* network = nullptr);
+                       std::map<std::string, bool> debug, PolicyNetwork* network = nullptr,
+                       const SimulationSettings* settings = nullptr);
 
     /**
      * @brief execute \n
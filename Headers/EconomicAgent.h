@@ -2,6 +2,10 @@
 #define ECONOMICAGENT_H
 
 #include "Agent.h"
+#include "Currency.h"
+
+// Forward Declarations
+class ValueHistogram;
 
 
 /**
@@ -52,11 +56,19 @@ public:
 
     /**
      * @brief getValue \n
-     * Getter function for the current value of the Agent.
+     * Getter function for the current value of the Agent, in whole units.
      * @return the current value of the agent as an int
      */
     int getValue();
 
+    /**
+     * @brief getBalance \n
+     * Getter function for the exact current value of the Agent, including
+     * any fraction of a unit received from payouts
+     * @return the current value of the agent as Currency
+     */
+    Currency getBalance();
+
     /**
      * @brief getStatus \n
      * Get the current economic status of the Agent, either NORMAL, HOMELESS,
@@ -91,10 +103,50 @@ public:
      */
     bool canReceiveUnemployment();
 
+    /**
+     * @brief setValueHistogram \n
+     * Setter function for the histogram used to chart and color the Agent.
+     * Once set, the Agent moves itself between the histogram's buckets and is
+     * marked dirty whenever its value crosses a threshold. Pass nullptr to
+     * remove the Agent from its histogram.
+     * @param histogram: pointer to the Agent value histogram of the Simulation
+     */
+    void setValueHistogram(ValueHistogram* histogram);
+
+    /**
+     * @brief getValueBucket \n
+     * Getter function for the value bucket the Agent currently falls into.
+     * Returns -1 if no value histogram has been set.
+     * @return the index of the value bucket as an int
+     */
+    int getValueBucket();
+
+    /**
+     * @brief setPerCapitaPayout \n
+     * Ties the Agent to a running per-capita payout. The Agent receives every
+     * payment added to the payout from now on, but none paid before.
+     * @param payout: pointer to the running total paid to each Agent
+     */
+    void setPerCapitaPayout(const Currency* payout);
+
 private:
 
-    /** Integer that stores the current economic value the agent possesses */
-    int economicValue;
+    /**
+     * @brief settlePayout \n
+     * Adds the payouts the Agent has not collected yet to its stored value.
+     * Must be called before the stored value is clamped.
+     */
+    void settlePayout();
+
+    /**
+     * @brief updateValueBucket \n
+     * Recomputes the value bucket of the Agent. If its value has crossed one
+     * of the thresholds, moves the Agent in its histogram and marks it dirty.
+     */
+    void updateValueBucket();
+
+    /** The current economic value the agent possesses */
+    Currency economicValue;
 
     /** Current economic status of the Agent */
     STATUS currentStatus;
@@ -108,6 +160,18 @@ private:
     /** Bool to track whether an Agent is eligible to receive unemployment */
     bool receiveUnemployment;
 
+    /** Pointer to the histogram counting the Agent's value bucket */
+    ValueHistogram* valueHistogram;
+
+    /** The value bucket the Agent currently falls into */
+    int valueBucket;
+
+    /** Pointer to the running total paid to each Agent, if any */
+    const Currency* perCapitaPayout;
+
+    /** The running payout when the Agent last collected it */
+    Currency payoutAtEntry;
+
 };
 
 #endif // ECONOMICAGENT_H
@@ -3,8 +3,14 @@
 
 #include <algorithm>
 #include <deque>
+#include <unordered_set>
+
+#include "QThreadPool"
+#include "QtConcurrentMap"
 
 #include "EconomicAgent.h"
+#include "EconomicLocation.h"
+#include "BusinessLedger.h"
 #include "Simulation.h"
 #include "AgentController.h"
 
@@ -25,17 +31,145 @@ private:
     /** Pointer to the Simulation this Controller interacts with */
     EconomicSimulation* sim;
 
-    /** Int to store the total value in all the agents */
-    int agentValue;
+    /** The total value in all the agents */
+    Currency agentValue;
 
-    /** Int to store the total value in all businesses */
-    int businessValue;
+    /** The total value in all businesses */
+    Currency businessValue;
 
     /** Deque to store the change in Economic value over the past 24 hours */
     std::deque<double> changeInValue;
 
     /** The value at the previous step in the Simulation */
-    int previousValue;
+    Currency previousValue;
+
+    /** Every Home Location, sorted from cheapest to most expensive */
+    std::vector<EconomicLocation*> homesByCost;
+
+    /** The cost of each home in homesByCost, in the same order */
+    std::vector<double> homeCosts;
+
+    /** Businesses that have gone bankrupt and are waiting to close */
+    std::vector<EconomicLocation*> pendingClosures;
+
+    /** The type of each new business waiting to open */
+    std::vector<QString> pendingOpenings;
+
+    /**
+     * @brief closeBusinesses \n
+     * Closes every business waiting to close. Employees become unemployed,
+     * every closed Work and Leisure location is removed from its Region in a
+     * single pass, and then the customers of every closed Leisure location are
+     * reassigned to the Leisure locations that remain.
+     */
+    void closeBusinesses();
+
+    /**
+     * @brief createBusiness \n
+     * Creates a new business and its sibling leisure location. Gives the
+     * business a small amount of initial value to get started. Hires up to
+     * five unemployed Agents (if there are none, a few employed Agents move
+     * over instead). The new leisure location takes in every Agent without
+     * one, plus a few random Agents.
+     * @param type: the type of location for the new business
+     * @param unemployed: unemployed Agents, in Simulation order. Agents that
+     * are hired are removed from the front.
+     * @param withoutLeisure: Agents without a leisure location. Cleared once
+     * they are assigned.
+     */
+    void createBusiness(QString type, std::vector<EconomicAgent*> &unemployed,
+                        std::vector<Agent*> &withoutLeisure);
+
+protected:
+
+    /** Number of hours since the last new business was generated */
+    int lastNewBusiness;
+
+    /** Economic state of every open business, stored by field */
+    BusinessLedger ledger;
+
+    /** Minimum number of Agents in each shard of the economic update. Each
+    Agent costs a few hundred nanoseconds, so smaller shards would spend more
+    time being dispatched to a thread than being updated */
+    static constexpr size_t ECONOMY_SHARD_MIN = 64;
+
+    /** A change in value an Agent caused at a business. A change with a
+    worker is a wage claim: the worker is only paid, and the business only
+    charged, if the business can still afford it when the claim is resolved */
+    struct ValueChange {
+        EconomicLocation* business;
+        Currency amount;
+        EconomicAgent* worker;
+    };
+
+    /** A job an unemployed Agent applied for, and whether they would take it */
+    struct JobApplication {
+        EconomicAgent* agent;
+        EconomicLocation* business;
+        bool accept;
+    };
+
+    /** A home that a homeless Agent can afford to move into */
+    struct HomeOffer {
+        EconomicAgent* agent;
+        EconomicLocation* home;
+    };
+
+    /** Range of Agents updated by one thread, along with every change to
+    shared state those Agents asked for. Agents only modify themselves while
+    the shards are updated, everything else waits for resolveShards. */
+    struct EconomicShard {
+        size_t begin;
+        size_t end;
+        unsigned long long seed;
+        Currency agentValue;
+        Currency redistributedValue;
+        std::vector<ValueChange> valueChanges;
+        std::vector<JobApplication> applications;
+        std::vector<HomeOffer> homeOffers;
+        std::vector<EconomicAgent*> evictions;
+    };
+
+    /**
+     * @brief createShards \n
+     * Splits the Agents into shards for the economic update. Every shard
+     * shares a single seed for the hour, so an Agent's rolls depend only on
+     * its index and not on which shard it lands in.
+     * @param numAgents: the number of Agents to update
+     * @param parallel: whether to split large populations into one shard per thread
+     * @return the shards covering every Agent, in order
+     */
+    std::vector<EconomicShard> createShards(size_t numAgents, bool parallel);
+
+    /**
+     * @brief resolveShards \n
+     * Applies the changes recorded by each shard in shard order. Business
+     * values change first, in the order the Agents recorded them: each wage
+     * claim is paid while the business's value is above its cost, and the
+     * business goes bankrupt at the first worker it can't pay. Then job
+     * applications are handled, and finally homeless Agents are housed and
+     * Agents who can't pay are made homeless. Because the shards cover the
+     * Agents in order, the result is the same on any number of threads.
+     * @param shards: the shards to resolve
+     */
+    void resolveShards(std::vector<EconomicShard> &shards);
+
+    /**
+     * @brief applyBusinessTurnover \n
+     * Closes every business that went bankrupt and opens every business that
+     * was generated since the last call, in one structural phase. Runs at the
+     * start of the hourly business update, while no Agent is being updated.
+     * Acquires the Agents lock.
+     */
+    void applyBusinessTurnover();
+
+    /**
+     * @brief getNumOpenBusinesses \n
+     * Counts the businesses that will be open once every pending closure and
+     * opening has been applied
+     * @return the number of open businesses as an int
+     */
+    int getNumOpenBusinesses();
 
 public:
 
@@ -84,9 +218,11 @@ public:
      * they run out of money, or unemployed if their place of work goes
      * bankrupt.
      * @param agent: the agent to perform the update on
+     * @param index: the index of the agent, used to draw its random rolls
+     * @param shard: the shard collecting changes to shared state
      * @return the amount of value the agent lost that will be redistributed to all businesses
      */
-    virtual double agentEconomicUpdate(EconomicAgent* agent);
+    virtual Currency agentEconomicUpdate(EconomicAgent* agent, size_t index, EconomicShard &shard);
 
     /**
      * @brief finishEconomicUpdate \n
@@ -97,19 +233,54 @@ public:
      * @param redistributedValue: the total amount of value to be distributed to businesses
      * @param type: the type of location for a newly generated business to be
      */
-    virtual void finishEconomicUpdate(double redistributedValue, QString type = "Economic");
+    virtual void finishEconomicUpdate(Currency redistributedValue, QString type = "Economic");
 
     /**
      * @brief bankruptBusiness \n
      * Bankrupts the victim EconomicLocation, which removes it and it's sibling
      * leisure location from the Simulation. All agents assigned to the business
      * location become unemployed. All agents assigned to the leisure location
-     * are randomly assigned to a new leisure location.
+     * are randomly assigned to a new leisure location. The business stops
+     * receiving redistributed value at once, and is closed along with every
+     * other bankrupt business at the start of the next business update.
      * @param victim: the EconomicLocation to be destroyed
-     * @param index: the index in the locations vector
      */
     void bankruptBusiness(EconomicLocation* victim);
 
+    /**
+     * @brief openBusiness \n
+     * Adds a Work Location to the business ledger so its economic state is
+     * updated along with every other business
+     * @param location: the Work Location that opened
+     */
+    void openBusiness(EconomicLocation* location);
+
+    /**
+     * @brief indexHomes \n
+     * Sorts the Home Locations by cost so homeless Agents can find a home they
+     * can afford without probing homes one at a time. Should be called once
+     * the Home Locations have been generated.
+     * @param homes: every Home Location in the Simulation
+     */
+    void indexHomes(const std::vector<Location*> &homes);
+
+    /**
+     * @brief getNumAffordableHomes \n
+     * Counts the homes an Agent can afford to move into. An Agent can afford a
+     * home that costs less than half of its value. Takes logarithmic time.
+     * @param value: the value of the Agent
+     * @return the number of affordable homes. These are the first entries of
+     * the homes sorted by cost.
+     */
+    int getNumAffordableHomes(int value);
+
+    /**
+     * @brief removeAgent \n
+     * Takes a dying Agent out of the Agent value histogram
+     * @param victim: pointer to the Agent being removed
+     */
+    virtual void removeAgent(Agent* victim) override;
+
     /**
      * @brief makeHomeless \n
      * Makes an agent homeless. Updates their status and sets their Home location
@@ -132,9 +303,11 @@ public:
      * agents lose value to various expenses, and some of that value gets given
      * back to businesses. Agents can go homeless while at home.
      * @param agent: agent to be updated
+     * @param index: the index of the agent, used to draw its random rolls
+     * @param shard: the shard collecting changes to shared state
      * @returns value lost by agent that should be distributed to businesses
      */
-    virtual double homeEconomicUpdate(EconomicAgent* agent);
+    virtual Currency homeEconomicUpdate(EconomicAgent* agent, size_t index, EconomicShard &shard);
 
     /**
      * @brief workEconomicUpdate \n
@@ -142,8 +315,10 @@ public:
      * agents gain value from working, and some of the value gets taken from
      * the business. Businesses can go bankrupt while workers are there
      * @param agent: agent to be updated
+     * @param index: the index of the agent, used to draw its random rolls
+     * @param shard: the shard collecting changes to shared state
      */
-    virtual void workEconomicUpdate(EconomicAgent* agent);
+    virtual void workEconomicUpdate(EconomicAgent* agent, size_t index, EconomicShard &shard);
 
     /**
      * @brief schoolEconomicUpdate \n
@@ -159,9 +334,11 @@ public:
      * agents lose value, all of which goes back to the sibling business location.
      * Agents have the potential to run out of money, but will not become homeless
      * until they return back home
-     * @param agent
+     * @param agent: agent to be updated
+     * @param index: the index of the agent, used to draw its random rolls
+     * @param shard: the shard collecting changes to shared state
      */
-    void leisureEconomicUpdate(EconomicAgent* agent);
+    void leisureEconomicUpdate(EconomicAgent* agent, size_t index, EconomicShard &shard);
 
     /**
      * @brief generateNewBusiness \n
@@ -169,7 +346,8 @@ public:
      * small amount of initial value to get started. Selects a small number of
      * unemployed individuals to work at this location (if no unemployed agents,
      * select a single employed agent). Also, creates a new sibling leisure
-     * location and assigned a small number of agents to it.
+     * location and assigned a small number of agents to it. The business
+     * opens at the start of the next business update.
      */
     void generateNewBusiness(QString type);
 
@@ -177,31 +355,31 @@ public:
      * @brief getTotalAgentValue \n
      * Getter function for the total amount of value held by Agents in the
      * Simulation
-     * @return an int
+     * @return the total agent value as Currency
      */
-    int getTotalAgentValue();
+    Currency getTotalAgentValue();
 
     /**
      * @brief getTotalBusinessValue \n
      * Getter function for the total amount of value held by Businesses in the
      * Simulation
-     * @return an int
+     * @return the total business value as Currency
      */
-    int getTotalBusinessValue();
+    Currency getTotalBusinessValue();
 
     /**
      * @brief setTotalBusinessValue \n
      * Setter function for the total amoutn of value held by Agents in the
      * Simulation
      */
-    void setTotalAgentValue(int newValue);
+    void setTotalAgentValue(Currency newValue);
 
     /**
      * @brief setTotalBusinessValue \n
      * Setter function for the total amoutn of value held by Businesses in the
      * Simulation
      */
-    void setTotalBusinessValue(int newValue);
+    void setTotalBusinessValue(Currency newValue);
 
     /**
      * @brief getState \n
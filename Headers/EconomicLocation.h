@@ -3,6 +3,10 @@
 
 #include "Location.h"
 #include "Agent.h"
+#include "BusinessLedger.h"
+
+// Forward Declarations
+class ValueHistogram;
 
 
 /**
@@ -15,13 +19,13 @@ class EconomicLocation : virtual public Location {
 private:
 
     /** The current economic value of the Location, only relevant for Work Locations */
-    double value;
+    Currency value;
 
     /** Track how much the Locations value has changed by today */
-    double dailyValueChange;
+    Currency dailyValueChange;
 
     /** Track how much the Locations value changed by yesterday */
-    double yesterdayValueChange;
+    Currency yesterdayValueChange;
 
     /** Track how many hours have passed since the business was created */
     int totalDays;
@@ -39,6 +43,31 @@ private:
     /** Cost associated with this specific location. Value an agent loses or gains at this location */
     double cost;
 
+    /** Pointer to the histogram counting the Location's value bucket */
+    ValueHistogram* valueHistogram;
+
+    /** The value bucket the Location currently falls into. Read by the
+    render thread while the simulation thread updates it */
+    std::atomic<int> valueBucket;
+
+    /** Ledger holding the economic state of this business, or nullptr if the
+    Location holds its own state. Only Work Locations are added to a ledger */
+    BusinessLedger* ledger;
+
+    /** Index of this business in its ledger, or -1 if it has no ledger */
+    int ledgerIndex;
+
+    /** The ledger moves state in and out of the Location directly */
+    friend class BusinessLedger;
+
+    /**
+     * @brief updateValueBucket \n
+     * Recomputes the value bucket of the Location. If its value has crossed
+     * one of the thresholds, moves it in its histogram and marks it and its
+     * sibling dirty.
+     */
+    void updateValueBucket();
+
 public:
 
     /**
@@ -49,8 +78,10 @@ public:
      * @param x: the x coordinate of the Location
      * @param y: the y coordinate of the Location
      * @param type: the type of location
+     * @param costRoll: a non-negative random int drawn by the Simulation,
+     * used to pick the cost of Work and Leisure locations
      */
-    EconomicLocation(double x, double y, Agent::LOCATIONS type);
+    EconomicLocation(double x, double y, Agent::LOCATIONS type, int costRoll);
 
     /**
      * @brief getValue \n
@@ -59,15 +90,16 @@ public:
      * Leisure Location will disappear.
      * @return the current economic value of the Location
      */
-    double getValue();
+    Currency getValue();
 
     /**
      * @brief incrementValue \n
      * Increment the economic value of the Location by a certain amount.
      * Will not allow the value of a Location to go below zero.
+     * @param amount: the amount to increment the value by
      * @return the new value of the Location
      */
-    double incrementValue(double amount);
+    Currency incrementValue(Currency amount);
 
     /**
      * @brief setSibling \n
@@ -116,7 +148,7 @@ public:
      * location is gaining or losing every day.
      * @return the total value change of this location from yesterday as an int
      */
-    double getYesterdayValueChange();
+    Currency getYesterdayValueChange();
 
     /**
      * @brief startNewDay \n
@@ -131,6 +163,32 @@ public:
      */
     int getDaysOpen();
 
+    /**
+     * @brief setValueHistogram \n
+     * Setter function for the histogram used to chart and color the Location.
+     * Once set, the Location moves itself between the histogram's buckets and
+     * is marked dirty whenever its value crosses a threshold. Pass nullptr to
+     * remove the Location from its histogram. Only relevant for Work locations.
+     * @param histogram: pointer to the business value histogram of the Simulation
+     */
+    void setValueHistogram(ValueHistogram* histogram);
+
+    /**
+     * @brief getValueBucket \n
+     * Getter function for the value bucket the Location currently falls into.
+     * Returns -1 if no value histogram has been set.
+     * @return the index of the value bucket as an int
+     */
+    int getValueBucket();
+
+    /**
+     * @brief setReceivingValue \n
+     * Sets whether a business receives its share of the value redistributed
+     * between businesses each hour. Has no effect outside of a ledger.
+     * @param receiving: whether the business should receive redistributed value
+     */
+    void setReceivingValue(bool receiving);
+
 };
 
 #endif // ECONOMICLOCATION_H
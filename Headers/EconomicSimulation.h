@@ -28,6 +28,9 @@ private:
     /** Double to track the total Economic Value held by agents */
     double agentEconomicValue;
 
+    /** Counter to determine if an hour has passed */
+    int numFrames;
+
     /** Pointer to a helper for rendering the Agent Value chart*/
     AgentValueChartHelper *agentValueHelper;
 
@@ -40,6 +43,15 @@ private:
     /** Pointer to a helper for rendering the Economic Status chart*/
     EconomicStatusChartHelper* statusHelper;
 
+    /**
+     * @brief getValueColor \n
+     * Determines the color that Agents and Locations in a value bucket should
+     * be rendered as
+     * @param bucket: the index of the value bucket
+     * @return the color of the bucket as a QColor
+     */
+    QColor getValueColor(int bucket);
+
 public:
     
     /**
@@ -50,9 +62,11 @@ public:
      * @param numAgents: the initial number of agents in the Simulation
      * @param ui: the MainWindow::ui containing information on all the user inputs
      * @param debug: a map of debug info about the Simulation
+     * @param settings: the settings to use if ui is nullptr
      */
     EconomicSimulation(int initialValue, int numAgents, Ui::MainWindow* ui,
-                       std::map<std::string, bool> debug);
+                       std::map<std::string, bool> debug,
+                       const SimulationSettings* settings = nullptr);
 
     /**
      * @brief execute \n
@@ -105,13 +119,31 @@ public:
     void updateEconomicCharts();
 
     /**
-     * @brief getBusinessThresholds \n
-     * Getter function for the individual value thresholds that Businesses are
-     * measured against. Theses thresholds help determine if the Business is
-     * a Low, Medium, or High value business location.
-     * @return a vector of value thresholds
+     * @brief collectAgentStats \n
+     * Adds the economic status of a single Agent to the statistics being
+     * collected, along with the base Simulation counts
+     * @param agent: the Agent to count
+     * @param stats: the statistics being collected
+     */
+    virtual void collectAgentStats(Agent* agent, SimulationStats &stats) override;
+
+    /**
+     * @brief collectLocationStats \n
+     * Copies the Agent and business value histograms into the statistics being
+     * collected. Takes the same time no matter how many Agents and businesses
+     * there are.
+     * @param stats: the statistics being collected
+     */
+    virtual void collectLocationStats(SimulationStats &stats) override;
+
+    /**
+     * @brief getBusinessHistogram \n
+     * Getter function for the running count of Businesses in each value
+     * bucket. The buckets determine if the Business is a Low, Medium, or High
+     * value business location.
+     * @return the histogram of business values
      */
-    std::vector<int>& getBusinessThresholds();
+    ValueHistogram& getBusinessHistogram();
 
     /**
      * @brief getNumHomelessAgents \n
@@ -0,0 +1,207 @@
+#ifndef ENSEMBLEEXECUTION_H
+#define ENSEMBLEEXECUTION_H
+
+#include <vector>
+#include <algorithm>
+
+#include "QObject"
+#include "QFutureWatcher"
+#include "QtConcurrentMap"
+
+#include "Simulation.h"
+
+// Forward Declarations
+class PandemicSimulation;
+
+
+/**
+ * @brief The EnsembleBand struct \n
+ * The low, median, and high quantiles of one quantity across every replicate
+ * of an ensemble, at each hour of the run
+ */
+struct EnsembleBand {
+    std::vector<double> low;
+    std::vector<double> median;
+    std::vector<double> high;
+};
+
+
+//******************************************************************************
+
+
+/**
+ * @brief The EnsembleRunner class \n
+ * Class that runs many independent replicates of a Pandemic or Dual Simulation
+ * at once, spread across the global thread pool. The replicates run without a
+ * UI, reading the settings the ensemble copied from the UI when it was
+ * created, and each one has its own seed, so no state is shared between them.
+ * The outcome of every replicate is recorded each hour and summarized into a
+ * median and a 5/95% band once all of them have finished.
+ */
+class EnsembleRunner : public QObject {
+    Q_OBJECT
+
+public:
+
+    /** Enum of the quantities recorded from each replicate every hour */
+    enum METRIC {SUSCEPTIBLE, EXPOSED, INFECTED, RECOVERED, TOTAL_CASES,
+                 TOTAL_DEATHS, TOTAL_VALUE, METRICS_MAX = 7};
+
+    /** Quantiles used for the low and high bands */
+    static constexpr double LOW_QUANTILE = 0.05;
+    static constexpr double HIGH_QUANTILE = 0.95;
+
+private:
+
+    /** Everything owned by a single replicate of the Simulation */
+    struct Replicate {
+        int index;
+        unsigned int seed;
+        PandemicSimulation* sim;
+    };
+
+    /** Settings every replicate reads in place of the UI */
+    SimulationSettings settings;
+
+    /** Debug info every replicate is created with */
+    std::map<std::string, bool> debug;
+
+    /** Initial number of Agents in each replicate */
+    int numAgents;
+
+    /** Number of days before the virus is introduced to each replicate */
+    int lagPeriod;
+
+    /** Number of Agents initially infected in each replicate */
+    int initialInfected;
+
+    /** Initial economic value of each Dual replicate */
+    int initialValue;
+
+    /** Type of Simulation to run, either "Pandemic" or "Dual" */
+    QString type;
+
+    /** Number of replicates in the ensemble */
+    int numReplicates;
+
+    /** Number of hours each replicate runs for */
+    int numHours;
+
+    /** Seed of the first replicate. Replicate i is seeded with seed + i */
+    unsigned int seed;
+
+    /** Every replicate in the ensemble */
+    std::vector<Replicate> replicates;
+
+    /** Hourly samples from every replicate, laid out as [metric][hour][replicate]
+    so that each replicate writes to its own slots without locking */
+    std::vector<double> samples;
+
+    /** Summary of each metric, indexed by the METRIC enum */
+    std::vector<EnsembleBand> bands;
+
+    /** Watcher that reports when every replicate has finished */
+    QFutureWatcher<void> watcher;
+
+    /**
+     * @brief createReplicate \n
+     * Creates the Simulation for a replicate, without a UI
+     * @param replicate: the replicate to create
+     */
+    void createReplicate(Replicate &replicate);
+
+    /**
+     * @brief runReplicate \n
+     * Runs a replicate for the full length of the ensemble, recording a sample
+     * every hour. Called on a thread from the global thread pool.
+     * @param replicate: the replicate to run
+     */
+    void runReplicate(Replicate &replicate);
+
+    /**
+     * @brief recordSample \n
+     * Records the current outcome of a replicate for one hour
+     * @param replicate: the replicate to record
+     * @param hour: the hour of the run being recorded
+     */
+    void recordSample(Replicate &replicate, int hour);
+
+    /**
+     * @brief summarize \n
+     * Reduces the samples of every replicate into a band for each metric
+     */
+    void summarize();
+
+    /**
+     * @brief writeSummary \n
+     * Writes the bands of every metric to a CSV file, one row per hour
+     * @param filename: the file to write to
+     * @return whether the file was written
+     */
+    bool writeSummary(const QString &filename);
+
+    /**
+     * @brief getQuantile \n
+     * Returns a quantile of a sorted range, interpolating between neighbors
+     * @param sorted: the values to take the quantile of, in ascending order
+     * @param quantile: the quantile to return, between zero and one
+     * @return the quantile as a double
+     */
+    static double getQuantile(const std::vector<double> &sorted, double quantile);
+
+public:
+
+    /**
+     * @brief EnsembleRunner \n
+     * Constructor for the EnsembleRunner class. Reads every setting the
+     * replicates need from the UI, so it must be called on the main thread.
+     * @param ui: the UI to read the ensemble's settings from
+     * @param type: the type of Simulation to run, either "Pandemic" or "Dual"
+     * @param numReplicates: the number of replicates to run
+     * @param numDays: the number of days each replicate runs for
+     * @param seed: the seed of the first replicate
+     */
+    EnsembleRunner(Ui::MainWindow* ui, QString type, int numReplicates,
+                   int numDays, unsigned int seed);
+
+    /**
+     * @brief startEnsemble \n
+     * Creates every replicate and starts running them on the global thread
+     * pool. Returns immediately; ensembleFinished is emitted once every
+     * replicate has finished.
+     */
+    void startEnsemble();
+
+    /**
+     * @brief getBands \n
+     * Getter function for the summary of each metric. Only valid once the
+     * ensemble has finished.
+     * @return the band of each metric, indexed by the METRIC enum
+     */
+    const std::vector<EnsembleBand>& getBands();
+
+    /** Destructor for the EnsembleRunner class. Waits for any replicates
+    that are still running */
+    ~EnsembleRunner();
+
+private slots:
+
+    /**
+     * @brief finishEnsemble \n
+     * Summarizes and saves the results once every replicate has finished,
+     * then frees the replicates
+     */
+    void finishEnsemble();
+
+signals:
+
+    /** Signal to indicate that the ensemble has finished and where its
+    summary was written */
+    void ensembleFinished(const QString &filename);
+
+    /** Signal to indicate that the ensemble wants to print a message */
+    void printMessage(const QString &message);
+
+};
+
+#endif // ENSEMBLEEXECUTION_H
@@ -0,0 +1,181 @@
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include "QString"
+#include "QFile"
+#include "QMutex"
+#include "QMutexLocker"
+#include "QThread"
+#include "QThreadPool"
+#include "QtConcurrentRun"
+
+
+/**
+ * @brief The EventLog class \n
+ * Append-only binary log of the individual events that drive a Simulation,
+ * such as hires, bankruptcies, infections and deaths, for offline analysis.
+ *
+ * Every record has the same fixed size. Each thread that records an event
+ * fills its own buffer, so recording only waits on another thread the first
+ * time a thread records into the log. Full buffers are handed to a single
+ * background writer and appended to the file while the Simulation keeps
+ * running. Records from different threads are not interleaved in time
+ * order, so readers should sort by hour when order matters.
+ */
+class EventLog {
+
+public:
+
+    /** Enum that specifies the kinds of events that can be recorded */
+    enum TYPE {HIRE, UNEMPLOYED, HOMELESS, BANKRUPTCY, NEW_BUSINESS,
+               EXPOSED, INFECTED, DEATH, TYPE_MAX};
+
+    /**
+     * @brief The Record struct \n
+     * A single event as it is stored in the file. Fields are ordered by size
+     * so the struct has no padding.
+     */
+    struct Record {
+        /** Hours since the start of the Simulation */
+        quint32 hour;
+
+        /** The TYPE of the event */
+        quint16 type;
+
+        /** Reserved, always zero */
+        quint16 flags;
+
+        /** ID of the Agent involved, or -1 */
+        qint32 agentID;
+
+        /** ID of the Location involved, or -1 */
+        qint32 locationID;
+
+        /** Economic value involved, in Currency units */
+        qint64 amount;
+    };
+
+    /** Bytes at the start of every event log file */
+    static const quint32 MAGIC = 0x474C5645;
+
+    /** Version of the file layout */
+    static const quint32 VERSION = 1;
+
+    /**
+     * @brief EventLog \n
+     * Constructor for the EventLog class. Creates the file and writes its
+     * header.
+     * @param filename: path of the file to write
+     */
+    EventLog(const QString &filename);
+
+    /**
+     * @brief isOpen \n
+     * Determines whether the file was created successfully
+     * @return true if events are being written
+     */
+    bool isOpen();
+
+    /**
+     * @brief getFilename \n
+     * Getter function for the path of the file being written
+     * @return the filename as a QString
+     */
+    QString getFilename();
+
+    /**
+     * @brief record \n
+     * Adds an event to the calling thread's buffer. Safe to call from any
+     * thread.
+     * @param type: the kind of event
+     * @param hour: hours since the start of the Simulation
+     * @param agentID: ID of the Agent involved, or -1
+     * @param locationID: ID of the Location involved, or -1
+     * @param amount: economic value involved, in Currency units
+     */
+    void record(TYPE type, int hour, int agentID, int locationID, long long amount);
+
+    /**
+     * @brief flush \n
+     * Writes every buffered event and waits for the writer to finish. Must
+     * not be called while other threads are recording events.
+     */
+    void flush();
+
+    /**
+     * @brief getTypeName \n
+     * Returns a readable name for a kind of event
+     * @param type: the kind of event
+     * @return the name as a QString
+     */
+    static QString getTypeName(int type);
+
+    /**
+     * @brief readLog \n
+     * Reads every record from an event log file, in the order they were written
+     * @param filename: path of the file to read
+     * @param records: vector that the records are appended to
+     * @return false if the file could not be read or is not an event log
+     */
+    static bool readLog(const QString &filename, std::vector<Record> &records);
+
+    /**
+     * @brief ~EventLog \n
+     * Destructor for the EventLog class. Flushes every buffered event and
+     * closes the file.
+     */
+    ~EventLog();
+
+private:
+
+    /** Number of records a thread buffers before handing them to the writer */
+    static const size_t BUFFER_RECORDS = 4096;
+
+    /** The file being appended to. Only touched by the writer thread once open */
+    QFile file;
+
+    /** Single thread that appends full buffers to the file in order */
+    QThreadPool writer;
+
+    /** Unique ID of this log. Each thread caches the buffer it was last
+    given along with the ID of the log it came from, so a thread that records
+    into a newer log never reuses a buffer from an older one */
+    quint64 instance;
+
+    /** The buffer of every thread that has recorded an event, owned by the
+    log so it is still written out by flush after the thread exits */
+    std::unordered_map<QThread*, std::unique_ptr<std::vector<Record>>> buffers;
+
+    /** Lock to provide mutual exclusion to the buffers map */
+    QMutex buffersLock;
+
+    /**
+     * @brief getBuffer \n
+     * Finds the calling thread's buffer, creating and registering it the
+     * first time the thread records an event in this log
+     * @return the calling thread's buffer
+     */
+    std::vector<Record>& getBuffer();
+
+    /**
+     * @brief submit \n
+     * Hands a buffer of records to the writer thread and leaves an empty
+     * buffer in its place
+     * @param buffer: the buffer to write out
+     */
+    void submit(std::vector<Record> &buffer);
+
+    /**
+     * @brief write \n
+     * Appends records to the end of the file. Only run on the writer thread.
+     * @param records: the records to write
+     */
+    void write(std::shared_ptr<std::vector<Record>> records);
+
+};
+
+#endif // EVENTLOG_H
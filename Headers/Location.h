@@ -1,6 +1,7 @@
 #ifndef LOCATION_H
 #define LOCATION_H
 
+#include <atomic>
 #include <unordered_set>
 
 #include "QGraphicsEllipseItem"
@@ -11,6 +12,7 @@
 
 // Forward declaration of the Agent Class
 class Agent;
+class Simulation;
 
 /**
  * @brief The Location class \n
@@ -39,6 +41,10 @@ private:
     /** Unique ID associated with each Location */
     int id;
 
+    /** Pointer to the Simulation this Location belongs to. Used to record
+    changes that require the Location to be redrawn */
+    Simulation* sim;
+
 public:
 
     /**
@@ -101,6 +107,15 @@ public:
      */
     std::unordered_set<Agent*> getAgents();
 
+    /**
+     * @brief getAgentSet \n
+     * Getter function for the set of Agents assigned to this location, without
+     * copying it. The set must not be iterated while Agents are added to or
+     * removed from this location.
+     * @return a reference to the Agent set
+     */
+    const std::unordered_set<Agent*>& getAgentSet();
+
     /**
      * @brief getID \n
      * Getter function for the unique ID associated with this location
@@ -115,6 +130,28 @@ public:
      */
     int getNumAgents();
 
+    /**
+     * @brief setSimulation \n
+     * Setter function for the Simulation that owns this Location. Temporary
+     * Locations are never given a Simulation and are never redrawn.
+     * @param sim: pointer to the owning Simulation
+     */
+    void setSimulation(Simulation* sim);
+
+    /**
+     * @brief markDirty \n
+     * Records that the rendered color of this Location may have changed. Only
+     * Locations that have been marked dirty are recolored on the next frame.
+     */
+    void markDirty();
+
+    /**
+     * @brief markChanged \n
+     * Records that the occupancy or state of this Location has changed, so
+     * the Simulation's controller can re-evaluate anything derived from it.
+     */
+    void markChanged();
+
     /** Destructor for the location class */
     virtual ~Location();
 
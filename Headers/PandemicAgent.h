@@ -20,7 +20,7 @@ public:
     enum STATUS {SUSCEPTIBLE, EXPOSED, INFECTED, RECOVERED};
 
     /** Enum that indicates the overal health of the agent */
-    enum HEALTH {HEALTHY, MODERATE, POOR, VERY_POOR};
+    enum HEALTH {HEALTHY, MODERATE, POOR, VERY_POOR, HEALTH_MAX = 4};
 
     /**
      * @brief PandemicAgent \n
@@ -49,6 +49,14 @@ public:
      */
     HEALTH getHealthStatus();
 
+    /**
+     * @brief rollHealthStatus \n
+     * Gives the agent a random health status, proportional to the US
+     * population. Agents are HEALTHY until this is called.
+     * @param roll: a non-negative random int drawn by the Simulation
+     */
+    void rollHealthStatus(int roll);
+
     /**
      * @brief setStatus \n
      * Set the current economic status of the Agent
@@ -57,12 +65,65 @@ public:
     void setStatus(STATUS newStatus);
 
     /**
-     * @brief advanceDay \n
-     * Advances the day for the current Agent. Increments the counter for the
-     * number of days the Agent resides in each stage.
+     * @brief advanceStage \n
+     * Moves the Agent to the next stage of the infection. Exposed Agents
+     * become Infected, Infected Agents Recover, and Recovered Agents become
+     * Susceptible again. Should only be called on the day the transition
+     * scheduled by sampleStageLength() is due.
      * @returns: whether the Agent should be counted as a new case
      */
-    bool advanceDay();
+    bool advanceStage();
+
+    /**
+     * @brief sampleStageLength \n
+     * Samples how many days the Agent will stay in its current stage. Rolls
+     * the same jittered daily thresholds that used to be checked every day,
+     * but all at once when the Agent enters the stage.
+     * @return the number of days until the next transition, or -1 if the
+     * Agent is Susceptible and has no transition to schedule
+     */
+    int sampleStageLength();
+
+    /**
+     * @brief getTransitionDay \n
+     * Getter function for the day the Agent's next transition is scheduled on
+     * @return the scheduled day, or -1 if no transition is scheduled
+     */
+    int getTransitionDay();
+
+    /**
+     * @brief setTransitionDay \n
+     * Setter function for the day the Agent's next transition is scheduled on
+     * @param day: the scheduled day, or -1 if no transition is scheduled
+     */
+    void setTransitionDay(int day);
+
+    /**
+     * @brief setLocation \n
+     * Overrides Agent::setLocation to also refresh whether the Agent is
+     * exposed at the new location
+     * @param location: a pointer to the new location
+     * @param which: specifies which of the Agent's locations to overwrite
+     */
+    virtual void setLocation(Location* location, LOCATIONS which);
+
+    /**
+     * @brief setLocationExposure \n
+     * Records whether one of the Agent's locations currently has Infected
+     * Agents associated with it. Called by PandemicLocation whenever its
+     * Infected count becomes or stops being positive.
+     * @param which: which of the Agent's locations changed
+     * @param exposed: whether the location has Infected Agents
+     */
+    void setLocationExposure(LOCATIONS which, bool exposed);
+
+    /**
+     * @brief hasExposedLocation \n
+     * Returns whether any of the Agent's locations has Infected Agents
+     * associated with it
+     * @return whether the Agent has been exposed at one of its locations
+     */
+    bool hasExposedLocation();
 
     /**
      * @brief makeSusceptible \n
@@ -89,13 +150,17 @@ public:
     void makeRecovered();
 
     /**
-     * @brief evaluateDeathProbability \n
-     * Function to determine if the Agent will die this hour or continue to live.
-     * The probability that an infected agent will die is proportional to their
-     * age and health status.
-     * @returns: whether the Agent dies or not
+     * @brief getDeathOdds \n
+     * Function to determine the odds of an infected Agent dying in a single
+     * hour. The probability that an infected agent will die is proportional
+     * to their age and health status, and rises when hospitals overflow.
+     * @param age: the age of the Agent
+     * @param healthStatus: the overall health of the Agent
+     * @param overflow: how many times over capacity the hospitals are, or zero
+     * if they are not over capacity
+     * @return N such that the Agent dies with probability 1/N each hour
      */
-    bool evaluateDeathProbability(int numInfected, int hospitalCapacity);
+    static int getDeathOdds(int age, HEALTH healthStatus, int overflow);
 
     /**
      * @brief setCompliance \n
@@ -124,10 +189,16 @@ public:
     /**
      * @brief evaluateInfectionProbability \n
      * Function to evaluate the probability of an Agent becoming exposed, based
-     * on the number of nearby infected agents.
+     * on the number of nearby infected agents. The random rolls are provided
+     * by the caller so that Agents can be evaluated on any thread.
+     * @param checkCompliance: whether compliance affects the infection chance
+     * @param guidelines: whether strong enough guidelines are in effect
+     * @param infectionRoll: non-negative random roll for becoming Exposed
+     * @param guidelineRoll: non-negative random roll for avoiding infection
      * @return whether the agent will become Exposed or not
      */
-    bool evaluateInfectionProbability(bool checkCompliance, bool guidelines);
+    bool evaluateInfectionProbability(bool checkCompliance, bool guidelines,
+                                      int infectionRoll, int guidelineRoll);
 
     /** Destructor for the Pandemic Agent class*/
     ~PandemicAgent();
@@ -143,9 +214,17 @@ private:
     /** Whether the Agent is complying with Pandemic rules or not */
     bool compliant;
 
-    /** Counter for the number of days the Agent has been in their current Pandemic status */
+    /** Number of days the Agent will have been in their current Pandemic status
+    when the next daily check is made */
     int daysInStage;
 
+    /** Day the Agent's next transition is scheduled on, or -1 if there is none */
+    int transitionDay;
+
+    /** Bitset over the LOCATIONS enum of the Agent's locations that currently
+    have Infected Agents */
+    unsigned int exposedLocations;
+
     /** Counter for the number of nearby Infected Agents */
     int nearbyInfected;
 
@@ -2,7 +2,13 @@
 #define PANDEMICCONTROLLER_H
 
 #include <algorithm>
+#include <cmath>
 #include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "QThreadPool"
+#include "QtConcurrentMap"
 
 #include "PandemicAgent.h"
 #include "Simulation.h"
@@ -19,8 +25,67 @@ class PandemicSimulation;
  */
 class PandemicController : virtual public AgentController {
 
+public:
+
+    /** Enum that specifies how the virus is transmitted between Agents */
+    enum TRANSMISSION {RADIUS, LOCATION_CONTACT};
+
+    /** Enum that specifies the strength of the active lockdown policy */
+    enum LOCKDOWN {NO_LOCKDOWN, WEAK_LOCKDOWN, MODERATE_LOCKDOWN,
+                   STRONG_LOCKDOWN, TOTAL_LOCKDOWN, LOCKDOWN_UNKNOWN};
+
+    /** Enum that specifies the strength of a weak/moderate/strong policy */
+    enum TIER {NO_TIER, WEAK_TIER, MODERATE_TIER, STRONG_TIER};
+
 private:
 
+    /** Strength of every intervention that applies to individual Agents,
+    read from the debug flags once per hour */
+    struct InterventionPolicy {
+        TIER compliance;
+        TIER guidelines;
+        TIER contactTracing;
+        TIER eCommerce;
+        bool quarantine;
+        bool totalLockdown;
+    };
+
+    /** Interventions in effect for the current hour */
+    InterventionPolicy policy;
+
+    /** Per-Agent destination kernel, specialized on which interventions are enabled */
+    typedef void (PandemicController::*DestinationKernel)(PandemicAgent*, Location*, int);
+
+    /** Destination kernel selected for the interventions in effect this hour */
+    DestinationKernel destinationKernel;
+
+    /**
+     * @brief readInterventionPolicy \n
+     * Reads the interventions in effect from the Simulation's debug flags and
+     * selects the destination kernel that matches them. Called once per hour.
+     */
+    void readInterventionPolicy();
+
+    /**
+     * @brief readTier \n
+     * Reads the strength of a weak/moderate/strong policy from the debug flags
+     * @param name: the name of the policy, without its strength
+     * @return the strongest tier of the policy that is enabled
+     */
+    TIER readTier(const std::string &name);
+
+    /**
+     * @brief updateDestination \n
+     * Updates the destination of a single Agent and enforces every enabled
+     * intervention. Interventions that are disabled for the hour are compiled
+     * out of each specialization.
+     * @param agent: the Agent to update
+     * @param home: the Location the Agent is sent to when staying home
+     * @param hour: the current hour
+     */
+    template <bool ECOMMERCE, bool QUARANTINE, bool CONTACT_TRACING, bool GUIDELINES>
+    void updateDestination(PandemicAgent* agent, Location* home, int hour);
+
     /** Pointer to the Simulation this Controller interacts with */
     PandemicSimulation* sim;
 
@@ -30,6 +95,9 @@ private:
     /** Whether an Agent's compliance will affect Infection spread */
     bool checkCompliance;
 
+    /** How the virus is transmitted between Agents for this run */
+    TRANSMISSION transmission;
+
     /** Total number of Deaths in the past day */
     int newDailyDeaths;
 
@@ -66,9 +134,103 @@ private:
     /** Boolean to store whether the initial infection has already happened */
     bool initialInfection;
 
+    /** Number of days covered by the transition calendar. Must be longer than
+    the longest stage an Agent can be scheduled for (21 days plus jitter) */
+    static constexpr int CALENDAR_DAYS = 32;
+
+    /** Calendar queue of scheduled stage transitions. Each bucket holds the
+    Agents whose next transition is due on a day that maps to its index */
+    std::vector<std::vector<PandemicAgent*>> transitionCalendar;
+
+    /** Number of days the controller has advanced through */
+    int currentDay;
+
+    /** Oldest age held in the mortality table. Agents die of old age at 100 */
+    static constexpr int MORTALITY_MAX_AGE = 100;
+
+    /** Odds of an Infected Agent dying this hour, indexed by
+    [age][health status] for the current level of hospital overflow */
+    std::vector<int> mortalityTable;
+
+    /** Hospital overflow the mortality table was built for, or -1 if the table
+    has not been built yet */
+    int mortalityOverflow;
+
+    /**
+     * @brief updateMortalityTable \n
+     * Rebuilds the mortality table if the hospital overflow has changed since
+     * it was last built
+     * @param hospitalCapacity: the number of Infected Agents the hospitals can
+     * treat before they overflow
+     */
+    void updateMortalityTable(int hospitalCapacity);
+
+    /** Lockdown policy the Location statuses were last evaluated under */
+    LOCKDOWN lockdownPolicy;
+
+    /** Locations whose lockdown status needs to be re-evaluated */
+    std::unordered_set<Location*> staleLocations;
+
+    /** Lock protecting the set of stale Locations */
+    QMutex staleLock;
+
+    /**
+     * @brief unscheduleTransition \n
+     * Removes an Agent's pending transition from the calendar, if it has one
+     * @param agent: the Agent to unschedule
+     */
+    void unscheduleTransition(PandemicAgent* agent);
+
     /** Radius through which the infection can spread */
     static constexpr int INFECTION_RADIUS = 16;
 
+    /** Contribution of an Exposed and an Infected Agent to the nearby infected
+    count of each Susceptible Agent at the same Location. Matches the weights
+    used by the radius model */
+    static constexpr int EXPOSED_CONTACT_WEIGHT = 1;
+    static constexpr int INFECTED_CONTACT_WEIGHT = 2;
+
+    /** Position and state of an Exposed or Infected Agent, binned by cell when
+    counting the nearby infected */
+    struct InfectiousAgent {
+        Coordinate position;
+        size_t index;
+        bool infected;
+    };
+
+    /**
+     * @brief getInfectionCell \n
+     * Returns the key of the cell that contains a position. Cells are squares
+     * as wide as the infection radius.
+     * @param position: the position to find the cell of
+     * @return the key of the cell as an unsigned long long
+     */
+    unsigned long long getInfectionCell(Coordinate position);
+
+    /**
+     * @brief getCellKey \n
+     * Packs the coordinates of a cell into a single key. The coordinates are
+     * converted to unsigned before they are shifted, since cells left of or
+     * above the origin have negative coordinates.
+     * @param cellX: the column of the cell
+     * @param cellY: the row of the cell
+     * @return the key of the cell as an unsigned long long
+     */
+    static unsigned long long getCellKey(long long cellX, long long cellY);
+
+    /** Minimum number of Agents in each chunk of the infection spread. An
+    Agent's roll is cheap, so a chunk needs this many to outweigh the cost of
+    dispatching it to a thread */
+    static constexpr size_t SPREAD_CHUNK_MIN = 128;
+
+    /** Range of Agents evaluated by one thread, along with the Agents that
+    became Exposed in that range */
+    struct SpreadChunk {
+        size_t begin;
+        size_t end;
+        std::vector<PandemicAgent*> newlyExposed;
+    };
+
 public:
 
     /**
@@ -110,21 +272,31 @@ public:
     void initializePandemicUpdate(std::vector<Agent*> &agents);
 
     /**
-     * @brief agentPandemicUpdate \n
-     * Performs the Pandemic update on a single agent. Counts the number of
-     * agents in each Pandemic status, and gives infected agent a chance to die.
-     * Additionally, counts the number of nearby infected agents near each agent.
-     * @param agent: the agent to update
-     * @param i: the index of the current agent
-     * @return whether the agent has died or not
+     * @brief evaluateMortality \n
+     * Gives every Infected Agent a chance to die this hour. The odds for each
+     * Agent are looked up in the mortality table and all of the rolls are
+     * drawn in one pass. No Agent is removed until applyMortality is called.
+     * @param pandemicAgents: the cast Agents, indexed like the agents vector
+     * @return the indices of the Agents that died, in ascending order
      */
-    virtual bool agentPandemicUpdate(PandemicAgent* agent, int i);
+    std::vector<int> evaluateMortality(const std::vector<PandemicAgent*> &pandemicAgents);
+
+    /**
+     * @brief applyMortality \n
+     * Removes every Agent that died from the Simulation in a single step and
+     * updates the death counts.
+     * @param pandemicAgents: the cast Agents. Dead Agents are set to nullptr
+     * @param deaths: the indices returned by evaluateMortality
+     */
+    void applyMortality(std::vector<PandemicAgent*> &pandemicAgents, const std::vector<int> &deaths);
 
     /**
      * @brief spreadInfection \n
      * Spreads the infection to Susceptible agents. The probability of a
      * Susceptible agent becoming Exposed is proportional to the number
-     * of infected agents that are close to the agent in questions
+     * of infected agents that are close to the agent in questions. Large
+     * populations are split across the global thread pool, with the new
+     * exposures counted per thread and summed afterwards.
      * @param pandemicAgents: a std::vector of PandemicAgents
      */
     void spreadInfection(std::vector<PandemicAgent*> &pandemicAgents);
@@ -140,10 +312,27 @@ public:
     /**
      * @brief advanceDay \n
      * Starts a new day for the pandemic controller. Updates the charts that
-     * display the daily counts of new Cases and Deaths.
+     * display the daily counts of new Cases and Deaths. Only the Agents with
+     * a transition scheduled for the new day are advanced.
      */
     void advanceDay();
 
+    /**
+     * @brief scheduleTransition \n
+     * Samples how long an Agent will stay in its current stage and places its
+     * next transition in the calendar. Should be called whenever an Agent
+     * enters a new stage. Replaces any transition already pending.
+     * @param agent: the Agent to schedule
+     */
+    void scheduleTransition(PandemicAgent* agent);
+
+    /**
+     * @brief removeAgent \n
+     * Removes a dying Agent's pending transition from the calendar
+     * @param victim: pointer to the Agent being removed
+     */
+    virtual void removeAgent(Agent* victim);
+
     /**
      * @brief getTotalCases \n
      * Getter function for the total number of Cases that have occurred in the
@@ -168,6 +357,13 @@ public:
      */
     int getTotalDeaths();
 
+    /**
+     * @brief hasInfectionBegun \n
+     * Getter function for whether the initial infection has happened yet
+     * @return whether the initial infection has happened
+     */
+    bool hasInfectionBegun();
+
     /**
      * @brief getDailyDeaths \n
      * Getter function for the number of new Deaths that have occured in the
@@ -248,19 +444,78 @@ public:
 
     /**
      * @brief lockdownLocations \n
-     * Function that will move through every location and lock them down if
-     * necessary, depending on the threshold specified in the UI.
+     * Function that will lock down locations if necessary, depending on the
+     * threshold specified in the UI. Only the Locations whose infected count
+     * or occupancy has changed are re-evaluated, unless the lockdown policy
+     * has changed, in which case every Location is.
+     */
+    void lockdownLocations();
+
+    /**
+     * @brief updateLockdownStatus \n
+     * Re-evaluates the Pandemic status of a single Location under the given
+     * lockdown policy.
+     * @param location: the Location to update
+     * @param policy: the active lockdown policy
      */
-    virtual void lockdownLocations();
+    virtual void updateLockdownStatus(PandemicLocation* location, LOCKDOWN policy);
 
     /**
-     * @brief incrementNearbyInfected \n
-     * Function to increment the number of nearby infected for all Agents within
-     * a constant radius of the specified agent
+     * @brief getLockdownPolicy \n
+     * Reads the active lockdown policy from the Simulation's debug flags
+     * @return the active lockdown policy as a LOCKDOWN
+     */
+    LOCKDOWN getLockdownPolicy();
+
+    /**
+     * @brief getLockdownThreshold \n
+     * Returns the infected proportion above which a Location is locked down
+     * under a weak, moderate, or strong lockdown policy
+     * @param policy: the active lockdown policy
+     * @return the threshold as a double
+     */
+    static double getLockdownThreshold(LOCKDOWN policy);
+
+    /**
+     * @brief locationChanged \n
+     * Marks a Location's lockdown status as needing to be re-evaluated
+     * @param location: pointer to the Location that changed
+     */
+    virtual void locationChanged(Location* location);
+
+    /**
+     * @brief removeLocation \n
+     * Forgets a Location that is about to be deleted
+     * @param victim: pointer to the Location being removed
+     */
+    virtual void removeLocation(Location* victim);
+
+    /**
+     * @brief accumulateNearbyInfected \n
+     * Function to count the nearby infected for every Susceptible Agent from the
+     * Exposed and Infected Agents within a constant radius. Bins the infectious
+     * Agents into cells in one pass, then sums the neighbors of each Susceptible
+     * Agent from the surrounding cells in a second pass.
      * @param pandemicAgents: std::vector of pointers to all Pandemic Agents in Simulation
-     * @param index: index of the Pandemic Agent to compare against
      */
-    void incrementNearbyInfected(std::vector<PandemicAgent*> &pandemicAgents, size_t index);
+    void accumulateNearbyInfected(std::vector<PandemicAgent*> &pandemicAgents);
+
+    /**
+     * @brief accumulateLocationContacts \n
+     * Function to count the nearby infected for every Susceptible Agent from
+     * the Exposed and Infected Agents heading to the same Location. Totals the
+     * infectious weight at each Location in one pass, then hands each
+     * Susceptible Agent the total at its Location in a second pass.
+     * @param pandemicAgents: std::vector of pointers to all Pandemic Agents in Simulation
+     */
+    void accumulateLocationContacts(std::vector<PandemicAgent*> &pandemicAgents);
+
+    /**
+     * @brief getTransmission \n
+     * Getter function for how the virus is transmitted between Agents
+     * @return the transmission model as a TRANSMISSION
+     */
+    TRANSMISSION getTransmission();
 
     /**
      * @brief getPandemicAgents \n
@@ -75,6 +75,16 @@ public:
     /** Destructor for the Pandemic Location class */
     ~PandemicLocation();
 
+protected:
+
+    /**
+     * @brief statusChanged \n
+     * Called by setStatus whenever the Pandemic status of the Location changes.
+     * Lets derived Locations react to a Location entering or leaving lockdown.
+     * @param previousStatus: the status the Location had before the change
+     */
+    virtual void statusChanged(PandemicLocation::STATUS previousStatus);
+
 private:
 
     /** The type of Location associated with this Pandemic Location */
@@ -86,6 +96,14 @@ private:
     /** Current number of Infected individuals associated with this location */
     int numInfectedAgents;
 
+    /**
+     * @brief updateAgentExposure \n
+     * Tells each Agent that holds this Location whether it currently has
+     * Infected Agents. Only needs to be called when the Infected count
+     * becomes or stops being positive.
+     */
+    void updateAgentExposure();
+
 };
 
 #endif // PANDEMICLOCATION_H
@@ -35,6 +35,21 @@ private:
     /** Number of agents to become infected in the initial infection */
     int initialInfected;
 
+    /** Counter to determine if an hour has passed */
+    int numFrames;
+
+    /** Whether the last call to execute fast-forwarded through a whole hour */
+    bool fastForwarded;
+
+    /**
+     * @brief canFastForward \n
+     * Checks whether the next hour can be fast-forwarded. The lag period is
+     * skipped an hour at a time when enabled, stopping before the hour in
+     * which the initial infection happens.
+     * @return whether the next hour can be fast-forwarded
+     */
+    bool canFastForward();
+
     /** Controller class to handle enforcing all Pandemic rules */
 //    PandemicController* controller;
 
@@ -62,9 +77,11 @@ public:
      * @param numAgents: the initial number of agents in the Simulation
      * @param ui: the MainWindow::ui containing information on all the user inputs
      * @param debug: a map of debug info about the Simulation
+     * @param settings: the settings to use if ui is nullptr
      */
     PandemicSimulation(int lagPeriod, int initialInfected, int initialValue, int numAgents,
-                       Ui::MainWindow* ui, std::map<std::string, bool> debug);
+                       Ui::MainWindow* ui, std::map<std::string, bool> debug,
+                       const SimulationSettings* settings = nullptr);
 
     /**
      * @brief execute \n
@@ -110,6 +127,15 @@ public:
      */
     std::vector<int> getNumSEIR();
 
+    /**
+     * @brief collectAgentStats \n
+     * Adds the Pandemic status of a single Agent to the statistics being
+     * collected, along with the Economic and base Simulation counts
+     * @param agent: the Agent to count
+     * @param stats: the statistics being collected
+     */
+    virtual void collectAgentStats(Agent* agent, SimulationStats &stats) override;
+
     /**
      * @brief getLagPeriod \n
      * Getter function for the Lag Period, or the number of Simulation days that
@@ -118,6 +144,14 @@ public:
      */
     int getLagPeriod();
 
+    /**
+     * @brief wasFastForwarded \n
+     * Getter function for whether the last call to execute fast-forwarded
+     * through a whole hour instead of running a single frame
+     * @return whether the last hour was fast-forwarded
+     */
+    bool wasFastForwarded();
+
     /**
      * @brief getInitialInfected \n
      * Getter function for the number of Agents that should become infected as a
@@ -135,6 +135,15 @@ public:
      */
     virtual void removeLocation(Location* location);
 
+    /**
+     * @brief removeLocations \n
+     * Removes several locations from the Region at once. Works like
+     * removeLocation, but closes the gaps in the locations vector in a single
+     * pass and keeps the remaining locations in order.
+     * @param victims: the locations to remove
+     */
+    void removeLocations(const std::vector<Location*> &victims);
+
     /**
      * @brief getGraphicsObject \n
      * Function to return a QGraphicsItem* corresponding
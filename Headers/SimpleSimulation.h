@@ -40,9 +40,11 @@ public:
      * It will implement agent assignment, motion, and behavior charts, however
      * it will lack any more advanced features like infectivity or economy.
      * @param numAgents: the specified number of agents in the simulation
+     * @param settings: the settings to use if ui is nullptr
      */
     SimpleSimulation(int numAgents, Ui::MainWindow* ui,
-                     std::map<std::string, bool> debug);
+                     std::map<std::string, bool> debug,
+                     const SimulationSettings* settings = nullptr);
 
     /**
      * @brief ~SimpleSimulation \n
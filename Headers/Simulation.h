@@ -5,6 +5,7 @@
 #include <random>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 
 #include "QObject"
@@ -16,6 +17,24 @@
 #include "Location.h"
 #include "Region.h"
 #include "ChartHelpers.h"
+#include "EventLog.h"
+
+
+/**
+ * @brief The SimulationSettings struct \n
+ * The settings a Simulation reads from the UI. A Simulation without a UI, such
+ * as an ensemble replicate, reads them from here instead, so it never touches
+ * a widget.
+ */
+struct SimulationSettings {
+    int canvasWidth;
+    int canvasHeight;
+    int numLocations;
+    int hospitalCapacity;
+};
+
+
+//******************************************************************************
 
 
 /**
@@ -37,9 +56,17 @@ private:
     /** AgentController to dynamically control agent behavior */
     AgentController* agentController;
 
-    /** ui element that allows simulation to inferface with the screen */
+    /** ui element that allows simulation to inferface with the screen, or
+    nullptr if the Simulation runs without one */
     Ui::MainWindow* ui;
 
+    /** Settings read in place of the UI when the Simulation has none */
+    SimulationSettings settings;
+
+    /** Graphics items of a Simulation without a UI. Nothing draws them, but
+    the Simulation owns them the way a scene would */
+    std::unordered_set<QGraphicsItem*> headlessItems;
+
     /** Integer containing the specified number of agents in the simulation */
     int initialNumAgents;
 
@@ -60,6 +87,12 @@ private:
     current day in the Sim*/
     int hour;
 
+    /** Counter to determine if an hour has passed */
+    int numFrames;
+
+    /** Bool to indicate whether the next frame is the first to be run */
+    bool firstFrame;
+
     /** Maps each distribution type to the Chart View(s) it appears in */
     std::unordered_map<QString, int>* chartViews;
 
@@ -82,6 +115,32 @@ private:
     QVector<QGraphicsItem*> addQueue;
     QVector<QGraphicsItem*> removeQueue;
 
+    /** Lock to provide mutual exclusion to the dirty Agent and Location sets */
+    QMutex* dirtyLock;
+
+    /** Sets of Agents and Locations whose color may have changed since the
+    last frame. Only these items are recolored when the screen is updated */
+    std::unordered_set<Agent*> dirtyAgents;
+    std::unordered_set<Location*> dirtyLocations;
+
+    /** Lock to provide mutual exclusion to the collected statistics */
+    QMutex* statsLock;
+
+    /** Most recent statistics collected from the Agents and Locations. Read
+    by the chart helpers instead of scanning the Agents on every render */
+    SimulationStats stats;
+
+    /** Bool to indicate whether any statistics have been collected yet */
+    bool statsCollected;
+
+    /** Binary log of individual events, or nullptr if events are not logged */
+    EventLog* eventLog;
+
+    /** Random engine owned by this Simulation. Every random choice the
+    Simulation makes is drawn from it, so Simulations on different threads
+    draw independent sequences that are reproducible from their seed */
+    std::mt19937 randomEngine;
+
     /** Bool to indicate whether the simulation has been reset. Helps synchronize
     between functions on separate threads */
     bool isReset;
@@ -113,8 +172,10 @@ public:
      * @param ui: the main window in which the simulation will runs
      * @param debug: a dict that contains the boolean values of various debug
      *               values;
+     * @param settings: the settings to use if ui is nullptr
      */
-    Simulation(int numAgents, Ui::MainWindow* ui, std::map<std::string, bool> debug);
+    Simulation(int numAgents, Ui::MainWindow* ui, std::map<std::string, bool> debug,
+               const SimulationSettings* settings = nullptr);
 
     /** Destructor for the Simulation Class*/
     virtual ~Simulation();
@@ -168,6 +229,22 @@ public:
      */
     int getNumLocations();
 
+    /**
+     * @brief getHospitalCapacity \n
+     * Getter function for the number of Infected Agents the hospitals can
+     * care for at once
+     * @return the hospital capacity as an int
+     */
+    int getHospitalCapacity();
+
+    /**
+     * @brief isHeadless \n
+     * Checks whether the Simulation should skip rendering. A Simulation
+     * without a UI is always headless.
+     * @return whether the Simulation is headless
+     */
+    bool isHeadless();
+
     /**
      * @brief addAgent \n
      * Function to add a new agent to the simulation. Will not
@@ -205,6 +282,14 @@ public:
      */
     void advanceTime();
 
+    /**
+     * @brief skipToEndOfHour \n
+     * Skips the remaining frames of the current hour, so that the next call to
+     * advanceTime advances the hour. Used to fast-forward the Simulation an
+     * hour at a time.
+     */
+    void skipToEndOfHour();
+
     /**
      * @brief killAgent \n
      * Function that handles killing an agent and deletes it from the
@@ -215,6 +300,23 @@ public:
      */
     void killAgent(Agent* victim, int index);
 
+    /**
+     * @brief killAgents \n
+     * Function that kills several agents at once. Each victim is released the
+     * same way as in killAgent, then the agents vector is compacted in a single
+     * pass. The surviving agents keep their relative order.
+     * @param indices: the indices in the agents vector to kill
+     */
+    void killAgents(const std::vector<int> &indices);
+
+    /**
+     * @brief releaseAgent \n
+     * Removes an agent from each Location it belongs to and from the screen,
+     * then deletes it. Does not touch the agents vector.
+     * @param victim: the agent to release
+     */
+    void releaseAgent(Agent* victim);
+
     /**
      * @brief birthAgent \n
      * Generate a single new agent with age zero. Assign it to a random set of
@@ -363,6 +465,14 @@ public:
      */
     void addToAddQueue(QGraphicsItem* item);
 
+    /**
+     * @brief addToAddQueue \n
+     * Adds several QGraphicsItems to the queue to be added to the screen,
+     * acquiring the addQueue lock once
+     * @param items: the QGraphicsItems to be added to the screen
+     */
+    void addToAddQueue(const QVector<QGraphicsItem*> &items);
+
     /**
      * @brief addToRemoveQueue \n
      * Adds a QGraphicsItem* to the queue to be removed from the screen. Acquires
@@ -371,6 +481,125 @@ public:
      */
     void addToRemoveQueue(QGraphicsItem* item);
 
+    /**
+     * @brief addToRemoveQueue \n
+     * Adds several QGraphicsItems to the queue to be removed from the screen,
+     * acquiring the removeQueue lock once
+     * @param items: the QGraphicsItems to be removed from the screen
+     */
+    void addToRemoveQueue(const QVector<QGraphicsItem*> &items);
+
+    /**
+     * @brief markDirty \n
+     * Records that an Agent needs to be recolored on the next frame. Acquires
+     * the dirty lock.
+     * @param agent: the Agent whose color may have changed
+     */
+    void markDirty(Agent* agent);
+
+    /**
+     * @brief markDirty \n
+     * Records that a Location needs to be recolored on the next frame. Acquires
+     * the dirty lock.
+     * @param location: the Location whose color may have changed
+     */
+    void markDirty(Location* location);
+
+    /**
+     * @brief unmarkDirty \n
+     * Removes an Agent from the dirty set. Must be called before an Agent is
+     * deleted so that it is never recolored after its death.
+     * @param agent: the Agent to remove
+     */
+    void unmarkDirty(Agent* agent);
+
+    /**
+     * @brief unmarkDirty \n
+     * Removes a Location from the dirty set. Must be called before a Location
+     * is deleted so that it is never recolored after its removal.
+     * @param location: the Location to remove
+     */
+    void unmarkDirty(Location* location);
+
+    /**
+     * @brief logEvent \n
+     * Records an event in the event log, stamped with the current hour. Does
+     * nothing unless the event log was enabled when the Simulation was
+     * created. Safe to call from any thread.
+     * @param type: the kind of event
+     * @param agentID: ID of the Agent involved, or -1
+     * @param locationID: ID of the Location involved, or -1
+     * @param amount: economic value involved, in Currency units
+     */
+    void logEvent(EventLog::TYPE type, int agentID, int locationID = -1, long long amount = 0);
+
+    /**
+     * @brief seedRandom \n
+     * Reseeds the Simulation's random engine. Must be called before init for
+     * the Agents and Locations to be reproducible from the seed.
+     * @param seed: the new seed
+     */
+    void seedRandom(unsigned int seed);
+
+    /**
+     * @brief getRandom \n
+     * Draws the next number from the Simulation's random engine. Used in place
+     * of rand(), whose state is shared by every thread on most platforms. Not
+     * safe to call from more than one thread at a time.
+     * @return a non-negative random int
+     */
+    int getRandom();
+
+    /**
+     * @brief takeDirtyAgents \n
+     * Returns every Agent that has been marked dirty since the last call and
+     * clears the dirty set. Should be called while holding the Agents lock.
+     * @return a std::vector of the dirty Agents
+     */
+    std::vector<Agent*> takeDirtyAgents();
+
+    /**
+     * @brief takeDirtyLocations \n
+     * Returns every Location that has been marked dirty since the last call and
+     * clears the dirty set. Should be called while holding the Location lock.
+     * @return a std::vector of the dirty Locations
+     */
+    std::vector<Location*> takeDirtyLocations();
+
+    /**
+     * @brief collectStats \n
+     * Fills a new SimulationStats struct in a single pass over the Agents and
+     * a single pass over the Locations, then replaces the stored statistics
+     * with it. Acquires the Agents and Location locks, so it must not be
+     * called while either is held.
+     */
+    void collectStats();
+
+    /**
+     * @brief getStats \n
+     * Getter function for the most recently collected statistics. Collects
+     * them first if they have never been collected. Acquires the stats lock.
+     * @return a copy of the most recent SimulationStats
+     */
+    SimulationStats getStats();
+
+    /**
+     * @brief collectAgentStats \n
+     * Adds a single Agent to the statistics being collected. Derived classes
+     * should override this to add their own counts and call the base version.
+     * @param agent: the Agent to count
+     * @param stats: the statistics being collected
+     */
+    virtual void collectAgentStats(Agent* agent, SimulationStats &stats);
+
+    /**
+     * @brief collectLocationStats \n
+     * Adds the Locations of the Simulation to the statistics being collected.
+     * The base Simulation does not track any Location statistics.
+     * @param stats: the statistics being collected
+     */
+    virtual void collectLocationStats(SimulationStats &stats);
+
     /**
      * @brief getRegion \n
      * Virtual method for getting a specific region from the Simulation. Must be
@@ -384,7 +613,8 @@ public:
      * @brief getUI \n
      * Getter function for the UI that the simulation controls. Enables the
      * simulation to directly manipulate the screen.
-     * @return a pointer to the UI on the screen
+     * @return a pointer to the UI on the screen, or nullptr if the Simulation
+     * runs without one
      */
     Ui::MainWindow* getUI();
 
@@ -5,6 +5,7 @@
 #include "QObject"
 #include "QThread"
 #include "QTimer"
+#include "QElapsedTimer"
 
 #include "Simulation.h"
 
@@ -22,8 +23,13 @@ class SimulationWorker : public QObject {
 
 public:
 
-    /** Enum that defines the different simulation framerates*/
-    enum Speed {PAUSED, SLOW, NORMAL, FAST, UNLIMITED};
+    /** Enum that defines the different simulation framerates. TURBO executes
+    timesteps back to back instead of waiting on the timer between them */
+    enum Speed {PAUSED, SLOW, NORMAL, FAST, UNLIMITED, TURBO};
+
+    /** Number of milliseconds spent executing timesteps in TURBO mode before
+    yielding to the event loop to handle pause and speed requests */
+    static constexpr int TURBO_BUDGET = 8;
 
     /**
      * @brief SimulationWorker \n
@@ -71,13 +77,15 @@ public slots:
     /**
      * @brief executeSimulation \n
      * Slot that directly executes the simulation. Signals to the parent
-     * Simulation of this worker to execute a timestep
+     * Simulation of this worker to execute a timestep. In TURBO mode, executes
+     * as many timesteps as fit in TURBO_BUDGET before signaling.
      */
     void executeSimTimestep();
 
 signals:
-    /** Signal that indicate that the thread has finished execution */
-    void timestepComplete(const QString &result);
+    /** Signal that indicate that the thread has finished execution. Reports
+    how many milliseconds were spent executing the Simulation */
+    void timestepComplete(const QString &result, double stepTime);
 
 private:
 
@@ -122,6 +130,31 @@ private:
     /** Current Speed of the Simulation*/
     SimulationWorker::Speed currentSpeed;
 
+    /** Number of frames per second the screen should be rendered at */
+    int targetFPS;
+
+    /** Clock started at the first render, used to schedule later frames */
+    QElapsedTimer frameClock;
+
+    /** Nanoseconds on the frame clock at which the next frame is due */
+    qint64 nextFrame;
+
+    /** Running average of the milliseconds taken to render the screen */
+    double averageRenderTime;
+
+    /** Milliseconds spent executing the Simulation since the last render */
+    double stepTimeSinceRender;
+
+    /** Default number of frames per second to render the screen at */
+    static constexpr int DEFAULT_TARGET_FPS = 30;
+
+    /** Largest share of the time that rendering may take away from the
+    Simulation when it is running as fast as possible */
+    static constexpr double MAX_RENDER_SHARE = 0.2;
+
+    /** Weight given to the newest measurement in the render time average */
+    static constexpr double RENDER_SMOOTHING = 0.2;
+
 public:
 
     /**
@@ -130,8 +163,12 @@ public:
      * controller class delegates SimulationWorkers to threads and assigns
      * tasks to the different workers to drive the simulation forward. Currently
      * only one worker is allocated
+     * @param sim: the Simulation to control
+     * @param frameRate: the initial speed of the Simulation
+     * @param targetFPS: the number of frames per second to render the screen at
      */
-    SimulationController(Simulation* sim, SimulationWorker::Speed frameRate);
+    SimulationController(Simulation* sim, SimulationWorker::Speed frameRate,
+                         int targetFPS = DEFAULT_TARGET_FPS);
 
     /** Destructor for the Simulation Controller class */
     ~SimulationController();
@@ -161,14 +198,26 @@ public:
      */
     void changeSpeed(SimulationWorker::Speed newSpeed);
 
+    /**
+     * @brief setTargetFPS \n
+     * Setter function for the number of frames per second the screen should
+     * be rendered at. Rendering may happen less often if it is expensive.
+     * Takes effect from the next rendered frame.
+     * @param targetFPS: the new target frame rate, at least 1
+     */
+    void setTargetFPS(int targetFPS);
+
 public slots:
 
     /**
      * @brief updateScreen \n
      * Function to handle the results of the previous timestep and render
-     * those results to the screen
+     * those results to the screen. Renders are paced to the target frame rate,
+     * and are skipped further when the measured render time would take too
+     * large a share of the time spent executing the Simulation.
+     * @param stepTime: milliseconds spent executing the previous timestep(s)
      */
-    void updateScreen(const QString &);
+    void updateScreen(const QString &, double stepTime);
 
 
 signals:
@@ -24,6 +24,7 @@ QT_END_NAMESPACE
 
 // Forward Declarations
 class TrainingController;
+class EnsembleRunner;
 
 
 /**
@@ -49,6 +50,9 @@ private:
     /** Controller that executes the Training in a separate thread */
     TrainingController* trainingController;
 
+    /** Runner for an ensemble of Simulations, or nullptr if none is running */
+    EnsembleRunner* ensembleRunner;
+
     /** Maximum numbers for agents and locations */
     static const int MAX_AGENTS = 1000;
     static const int MAX_LOCATIONS = 100;
@@ -211,6 +215,14 @@ public:
      */
     static std::map<std::string, bool> checkDebugInfo(Ui::MainWindow* ui);
 
+    /**
+     * @brief readSettings \n
+     * Function that reads the settings a Simulation needs from the UI into a
+     * plain struct, so that a Simulation can run without the UI
+     * @return the current settings
+     */
+    static SimulationSettings readSettings(Ui::MainWindow* ui);
+
 private slots:
     /**
      * @brief on_runSimulation_clicked \n
@@ -399,6 +411,14 @@ private slots:
      */
     void on_hospitalCapacity_valueChanged(int arg1);
 
+    /**
+     * @brief on_displayFPS_valueChanged \n
+     * Event handler for when the SpinBox for the display frame rate changes.
+     * Updates the target frame rate of the running Simulation, if any.
+     * @param arg1: the new value of the SpinBox
+     */
+    void on_displayFPS_valueChanged(int arg1);
+
     /**
      * @brief on_hospitalCapacitySlider_valueChanged \n
      * Event handler for when the Slider for the Initial Infected changes.
@@ -426,6 +446,22 @@ private slots:
      */
     void on_evaluateNetwork_clicked();
 
+    /**
+     * @brief on_runEnsemble_clicked \n
+     * Runs an ensemble of independent replicates of the current Pandemic or
+     * Dual Simulation in the background, using the current settings. The
+     * median and 5/95% bands of the outcomes are written to a CSV file once
+     * every replicate has finished.
+     */
+    void on_runEnsemble_clicked();
+
+    /**
+     * @brief finishEnsemble \n
+     * Frees the ensemble once it has finished and re-enables the UI
+     * @param filename: the file the ensemble summary was written to
+     */
+    void finishEnsemble(const QString &filename);
+
 public slots:
 
     /**
@@ -1,7 +1,14 @@
 #include <Headers/Agent.h>
+#include "Headers/Simulation.h"
+
+#include <atomic>
 
 Agent::Agent(int age, Location* startingLocation, QString startingLocationString,
              int behavior) {
+    // Give each Agent a unique ID
+    static std::atomic<int> id_counter(0);
+    this->id = id_counter++;
+
     // Initialize the Agent's age
     this->age = age;
 
@@ -22,6 +29,9 @@ Agent::Agent(int age, Location* startingLocation, QString startingLocationString
 
     // Assign the agent a specific behavior
     this->behavior = behavior;
+
+    // The agent does not belong to a Simulation until it is added to one
+    this->sim = nullptr;
 }
 
 
@@ -55,9 +65,9 @@ void Agent::takeTimeStep() {
         this->speed = BASE_SPEED;
 
         // Update the agents position randomly
-        position.setCoord(position.getCoord(Coordinate::X) + (rand() % 3 - 1),
+        position.setCoord(position.getCoord(Coordinate::X) + (sim->getRandom() % 3 - 1),
                            Coordinate::X);
-        position.setCoord(position.getCoord(Coordinate::Y) + (rand() % 3 - 1),
+        position.setCoord(position.getCoord(Coordinate::Y) + (sim->getRandom() % 3 - 1),
                            Coordinate::Y);
     } else {
         // Else, move in a straight line toward the destination
@@ -75,11 +85,21 @@ void Agent::takeTimeStep() {
 //******************************************************************************
 
 
+void Agent::arriveAtDestination() {
+    this->position = this->destination;
+    this->speed = BASE_SPEED;
+}
+
+
+//******************************************************************************
+
+
 void Agent::setDestination(Location& newLocation, QString destinationType) {
 
     // Update the destination of the agent
     this->destination = newLocation.getPosition();
     this->destinationString = destinationType;
+    this->destinationID = newLocation.getID();
 
     // Ensure the agent arrives in no more than 30 frames
     double dist = this->position.distBetween(this->destination);
@@ -98,6 +118,14 @@ QString Agent::getDestinationString() {
 //******************************************************************************
 
 
+int Agent::getDestinationID() {
+    return destinationID;
+}
+
+
+//******************************************************************************
+
+
 void Agent::setLocation(Location *location, LOCATIONS which) {
     this->locations[static_cast<int>(which)] = location;
 }
@@ -180,6 +208,14 @@ int Agent::incrementAge() {
 //******************************************************************************
 
 
+int Agent::getID() {
+    return this->id;
+}
+
+
+//******************************************************************************
+
+
 void Agent::setColor(QColor color) {
     rect->setPen(color);
 }
@@ -188,4 +224,32 @@ void Agent::setColor(QColor color) {
 //******************************************************************************
 
 
+void Agent::setSimulation(Simulation* sim) {
+    this->sim = sim;
+}
+
+
+//******************************************************************************
+
+
+void Agent::markDirty() {
+    if (sim != nullptr) {
+        sim->markDirty(this);
+    }
+}
+
+
+//******************************************************************************
+
+
+void Agent::logEvent(EventLog::TYPE type, int locationID, long long amount) {
+    if (sim != nullptr) {
+        sim->logEvent(type, id, locationID, amount);
+    }
+}
+
+
+//******************************************************************************
+
+
 Agent::~Agent() {}
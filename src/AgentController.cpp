@@ -11,7 +11,7 @@ QString AgentController::evaluateDestinationProbabilities(QStringList &keys,
 
     // Randomly sample a value in [0,weightedSum). Return the first key for
     // which this random value is less than the weighted sum
-    int random = rand() % weightedSum;
+    int random = sim->getRandom() % weightedSum;
     for (size_t i = 0; i < probabilities.size(); ++i) {
         if (random < probabilities[i]) {
             return keys.at(static_cast<int>(i));
@@ -185,7 +185,7 @@ int AgentController::getNumAdultBehaviors() {
 
 int AgentController::getAdultBehavior() {
     // Generate a random number in the range [0, adultWeightedSum)
-    int random_num = rand() % adultWeightedSum;
+    int random_num = sim->getRandom() % adultWeightedSum;
 
     for (size_t i = 0; i < adultProbabilities.size(); ++i) {
         if (random_num < adultProbabilities[i]) {
@@ -210,7 +210,7 @@ int AgentController::getNumChildBehaviors() {
 
 int AgentController::getChildBehavior() {
     // Generate a random number in the range [0, adultWeightedSum)
-    int random_num = rand() % childWeightedSum;
+    int random_num = sim->getRandom() % childWeightedSum;
 
     for (size_t i = 0; i < childProbabilities.size(); ++i) {
         if (random_num < childProbabilities[i]) {
@@ -265,7 +265,7 @@ int AgentController::sampleAgentAge() {
     static std::vector<int> ageWeightedSums = {25, 35, 65, 87, 100};
 
     // Randomly sample a number in the range of [0, weightedTotal)
-    int randNum = rand() % weightedTotal;
+    int randNum = sim->getRandom() % weightedTotal;
 
     // Find the first weighted sum that is greater than the randNum
     int index = 0;
@@ -278,7 +278,7 @@ int AgentController::sampleAgentAge() {
 
     // Randomly sample an age from within the sampled age range
     int rangeSize = ages[index + 1] - ages[index];
-    randNum = rand() % rangeSize;
+    randNum = sim->getRandom() % rangeSize;
     return ages[index] + randNum;
 }
 
@@ -304,8 +304,7 @@ QMutex* AgentController::getLocationLock() {
 void AgentController::updateSingleDestination(Agent* agent, int hour, bool randomAllowed) {
 
     // Chance for going to a random location
-    static int randomChance = 5;
-    randomChance = randomAllowed ? 5 : 0;
+    int randomChance = randomAllowed ? 5 : 0;
 
     // Determine to where the agent will be assigned
     QString destinationString = getAgentDestination(agent, hour);
@@ -317,7 +316,7 @@ void AgentController::updateSingleDestination(Agent* agent, int hour, bool rando
         return;
     } else if (destinationString == "Home") {
         // Random chance of going to a random Home location
-        if (rand() % 100 < randomChance) {
+        if (sim->getRandom() % 100 < randomChance) {
             newDestination = sim->getRandomLocation(Agent::HOME);
         } else {
             newDestination = agent->getLocation(Agent::HOME);
@@ -331,7 +330,7 @@ void AgentController::updateSingleDestination(Agent* agent, int hour, bool rando
         }
     } else if (destinationString == "School") {
         // Random chance of going to a random Home location
-        if (rand() % 100 < randomChance) {
+        if (sim->getRandom() % 100 < randomChance) {
             newDestination = sim->getRandomLocation(Agent::SCHOOL);
         } else {
             newDestination = agent->getLocation(Agent::SCHOOL);
@@ -339,7 +338,7 @@ void AgentController::updateSingleDestination(Agent* agent, int hour, bool rando
         randomPosition = sim->getRegion(Agent::SCHOOL)->getRandomCoordinate();
     } else if (destinationString == "Work") {
         // Random chance of going to a random Home location
-        if (rand() % 100 < randomChance) {
+        if (sim->getRandom() % 100 < randomChance) {
             newDestination = sim->getRandomLocation(Agent::WORK);
         } else {
             newDestination = agent->getLocation(Agent::WORK);
@@ -347,7 +346,7 @@ void AgentController::updateSingleDestination(Agent* agent, int hour, bool rando
         randomPosition = sim->getRegion(Agent::WORK)->getRandomCoordinate();
     } else if (destinationString == "Leisure") {
         // Random chance of going to a random Home location
-        if (rand() % 100 < randomChance) {
+        if (sim->getRandom() % 100 < randomChance) {
             newDestination = sim->getRandomLocation(Agent::LEISURE);
         } else {
             newDestination = agent->getLocation(Agent::LEISURE);
@@ -382,6 +381,38 @@ Simulation* AgentController::getSim() {
 //******************************************************************************
 
 
+void AgentController::removeAgent(Agent*) {}
+
+
+//******************************************************************************
+
+
+void AgentController::locationChanged(Location*) {}
+
+
+//******************************************************************************
+
+
+void AgentController::removeLocation(Location*) {}
+
+
+//******************************************************************************
+
+
+int AgentController::getRandomRoll(unsigned long long seed, size_t index, unsigned int stream) {
+    // SplitMix64 finalizer over the seed, the Agent, and the stream
+    unsigned long long z = seed + (static_cast<unsigned long long>(index) * ROLL_STREAMS + stream + 1) *
+                                  0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    return static_cast<int>(z >> 33);
+}
+
+
+//******************************************************************************
+
+
 AgentController::~AgentController() {}
 
 
@@ -0,0 +1,362 @@
+#include "Headers/BusinessLedger.h"
+#include "Headers/EconomicLocation.h"
+
+BusinessLedger::BusinessLedger() {
+    this->numShareholders = 0;
+}
+
+
+//******************************************************************************
+
+
+void BusinessLedger::addBusiness(EconomicLocation *location) {
+    if (location->ledger != nullptr) {
+        return;
+    }
+
+    // Copy the Location's current state into the end of each array
+    locations.push_back(location);
+    values.push_back(location->value);
+    costs.push_back(location->cost);
+    dailyValueChanges.push_back(location->dailyValueChange);
+    yesterdayValueChanges.push_back(location->yesterdayValueChange);
+    daysOpen.push_back(location->totalDays);
+    dailyHires.push_back(location->dailyHire);
+
+    // New businesses only share in value distributed after they open
+    dividendsAtEntry.push_back(dividendPerShare);
+    shareholders.push_back(true);
+    numShareholders++;
+
+    location->ledger = this;
+    location->ledgerIndex = static_cast<int>(locations.size()) - 1;
+
+    vacancySlots.push_back(-1);
+    updateVacancy(location->ledgerIndex);
+}
+
+
+//******************************************************************************
+
+
+void BusinessLedger::removeBusiness(EconomicLocation *location) {
+    if (location->ledger != this) {
+        return;
+    }
+
+    // Collect any value distributed to the business since it was last settled
+    int index = location->ledgerIndex;
+    settle(index);
+    if (shareholders[index]) {
+        numShareholders--;
+    }
+    removeVacancy(index);
+
+    // Copy the state back into the Location so it stays readable
+    location->value = values[index];
+    location->cost = costs[index];
+    location->dailyValueChange = dailyValueChanges[index];
+    location->yesterdayValueChange = yesterdayValueChanges[index];
+    location->totalDays = daysOpen[index];
+    location->dailyHire = dailyHires[index];
+    location->ledger = nullptr;
+    location->ledgerIndex = -1;
+
+    // Move the last entry into the removed slot
+    int last = static_cast<int>(locations.size()) - 1;
+    if (index != last) {
+        locations[index] = locations[last];
+        values[index] = values[last];
+        costs[index] = costs[last];
+        dailyValueChanges[index] = dailyValueChanges[last];
+        yesterdayValueChanges[index] = yesterdayValueChanges[last];
+        daysOpen[index] = daysOpen[last];
+        dailyHires[index] = dailyHires[last];
+        dividendsAtEntry[index] = dividendsAtEntry[last];
+        shareholders[index] = shareholders[last];
+        vacancySlots[index] = vacancySlots[last];
+        locations[index]->ledgerIndex = index;
+
+        // Point the moved business's vacancy at its new index
+        if (vacancySlots[index] != -1) {
+            vacancies[vacancySlots[index]] = index;
+        }
+    }
+
+    locations.pop_back();
+    values.pop_back();
+    costs.pop_back();
+    dailyValueChanges.pop_back();
+    yesterdayValueChanges.pop_back();
+    daysOpen.pop_back();
+    dailyHires.pop_back();
+    dividendsAtEntry.pop_back();
+    shareholders.pop_back();
+    vacancySlots.pop_back();
+}
+
+
+//******************************************************************************
+
+
+int BusinessLedger::size() {
+    return static_cast<int>(locations.size());
+}
+
+
+//******************************************************************************
+
+
+EconomicLocation* BusinessLedger::getLocation(int index) {
+    return locations[index];
+}
+
+
+//******************************************************************************
+
+
+Currency BusinessLedger::getValue(int index) {
+    return values[index] + getPendingDividend(index);
+}
+
+
+//******************************************************************************
+
+
+Currency BusinessLedger::incrementValue(int index, Currency amount) {
+    settle(index);
+    Currency newValue = std::max(values[index] + amount, Currency());
+    dailyValueChanges[index] += (newValue - values[index]);
+    values[index] = newValue;
+    return newValue;
+}
+
+
+//******************************************************************************
+
+
+double BusinessLedger::getCost(int index) {
+    return costs[index];
+}
+
+
+//******************************************************************************
+
+
+Currency BusinessLedger::getYesterdayValueChange(int index) {
+    return yesterdayValueChanges[index];
+}
+
+
+//******************************************************************************
+
+
+int BusinessLedger::getDaysOpen(int index) {
+    return daysOpen[index];
+}
+
+
+//******************************************************************************
+
+
+bool BusinessLedger::makeHire(int index) {
+    if (canHire(index)) {
+        dailyHires[index] = true;
+        removeVacancy(index);
+        return true;
+    }
+    return false;
+}
+
+
+//******************************************************************************
+
+
+int BusinessLedger::getNumVacancies() {
+    return static_cast<int>(vacancies.size());
+}
+
+
+//******************************************************************************
+
+
+EconomicLocation* BusinessLedger::getVacancy(int slot) {
+    return locations[vacancies[slot]];
+}
+
+
+//******************************************************************************
+
+
+void BusinessLedger::setShareholder(int index, bool shareholder) {
+    // Settle first so the business keeps what it was owed under its old status
+    settle(index);
+    if (shareholders[index] != shareholder) {
+        shareholders[index] = shareholder;
+        numShareholders += shareholder ? 1 : -1;
+    }
+}
+
+
+//******************************************************************************
+
+
+bool BusinessLedger::distribute(Currency amount) {
+    if (numShareholders == 0) {
+        return false;
+    }
+
+    // Pay out equal shares and hold back the remainder for the next
+    // distribution, so no value is created or lost by rounding
+    Currency total = amount + undistributed;
+    Currency share = total.dividedBy(numShareholders);
+    dividendPerShare += share;
+    undistributed = total - share.multipliedBy(numShareholders);
+    refreshValueBuckets();
+    return true;
+}
+
+
+//******************************************************************************
+
+
+int BusinessLedger::getNumShareholders() {
+    return numShareholders;
+}
+
+
+//******************************************************************************
+
+
+void BusinessLedger::startNewDay() {
+    // Value distributed before midnight counts towards the day that is ending
+    for (size_t i = 0; i < locations.size(); ++i) {
+        settle(static_cast<int>(i));
+    }
+
+    yesterdayValueChanges.swap(dailyValueChanges);
+    std::fill(dailyValueChanges.begin(), dailyValueChanges.end(), Currency());
+    std::fill(dailyHires.begin(), dailyHires.end(), 0);
+    for (size_t i = 0; i < daysOpen.size(); ++i) {
+        daysOpen[i]++;
+    }
+
+    // Yesterday's value changes decide which businesses can hire today
+    vacancies.clear();
+    std::fill(vacancySlots.begin(), vacancySlots.end(), -1);
+    for (size_t i = 0; i < locations.size(); ++i) {
+        updateVacancy(static_cast<int>(i));
+    }
+}
+
+
+//******************************************************************************
+
+
+void BusinessLedger::applyOverhead(Currency amount) {
+    for (size_t i = 0; i < values.size(); ++i) {
+        settle(static_cast<int>(i));
+        Currency newValue = std::max(values[i] - amount, Currency());
+        dailyValueChanges[i] += (newValue - values[i]);
+        values[i] = newValue;
+    }
+    refreshValueBuckets();
+}
+
+
+//******************************************************************************
+
+
+Currency BusinessLedger::getTotalValue() {
+    Currency total;
+    for (size_t i = 0; i < values.size(); ++i) {
+        total += getValue(static_cast<int>(i));
+    }
+    return total;
+}
+
+
+//******************************************************************************
+
+
+std::vector<EconomicLocation*> BusinessLedger::getBankruptcyCandidates() {
+    std::vector<EconomicLocation*> candidates;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (getValue(static_cast<int>(i)) == Currency()) {
+            candidates.push_back(locations[i]);
+        }
+    }
+    return candidates;
+}
+
+
+//******************************************************************************
+
+
+Currency BusinessLedger::getPendingDividend(int index) {
+    if (!shareholders[index]) {
+        return Currency();
+    }
+    return dividendPerShare - dividendsAtEntry[index];
+}
+
+
+//******************************************************************************
+
+
+void BusinessLedger::settle(int index) {
+    Currency pending = getPendingDividend(index);
+    values[index] += pending;
+    dailyValueChanges[index] += pending;
+    dividendsAtEntry[index] = dividendPerShare;
+}
+
+
+//******************************************************************************
+
+
+bool BusinessLedger::canHire(int index) {
+    return yesterdayValueChanges[index] > Currency::fromDouble(2 * costs[index]) &&
+            !dailyHires[index];
+}
+
+
+//******************************************************************************
+
+
+void BusinessLedger::updateVacancy(int index) {
+    if (!canHire(index)) {
+        removeVacancy(index);
+    } else if (vacancySlots[index] == -1) {
+        vacancySlots[index] = static_cast<int>(vacancies.size());
+        vacancies.push_back(index);
+    }
+}
+
+
+//******************************************************************************
+
+
+void BusinessLedger::removeVacancy(int index) {
+    int slot = vacancySlots[index];
+    if (slot == -1) {
+        return;
+    }
+
+    // Move the last vacancy into the removed slot
+    int lastIndex = vacancies.back();
+    vacancies[slot] = lastIndex;
+    vacancySlots[lastIndex] = slot;
+    vacancies.pop_back();
+    vacancySlots[index] = -1;
+}
+
+
+//******************************************************************************
+
+
+void BusinessLedger::refreshValueBuckets() {
+    for (size_t i = 0; i < locations.size(); ++i) {
+        locations[i]->updateValueBucket();
+    }
+}
@@ -1,6 +1,25 @@
+#include <cmath>
+
 #include "Headers/ChartHelpers.h"
 
 
+SimulationStats::SimulationStats(int numAdultBehaviors, int numChildBehaviors) {
+    ageCounts = std::vector<int>(NUM_AGE_BUCKETS, 0);
+    adultBehaviorCounts = std::vector<int>(numAdultBehaviors, 0);
+    childBehaviorCounts = std::vector<int>(numChildBehaviors, 0);
+    destinationCounts = std::vector<int>(Agent::LOCATIONS_MAX, 0);
+    agentValueCounts = std::vector<int>(NUM_VALUE_BUCKETS, 0);
+    businessValueCounts = std::vector<int>(NUM_VALUE_BUCKETS, 0);
+    SEIRCounts = std::vector<int>(4, 0);
+    numHomeless = 0;
+    numUnemployed = 0;
+    numAgents = 0;
+}
+
+
+//******************************************************************************
+
+
 QtCharts::QBarSet* AgeChartHelper::getNewBarSet() {
 
     if (barSet == nullptr) {
@@ -97,10 +116,10 @@ AgeChartHelper::~AgeChartHelper() {
 //******************************************************************************
 
 
-QtCharts::QChart* AgeChartHelper::getChart(std::vector<Agent*> *agents) {
+QtCharts::QChart* AgeChartHelper::getChart(const SimulationStats &stats) {
 
     // Create an updated BarSet with counts
-    updateChart(agents);
+    updateChart(stats);
 
     // Initialize a QBarSeries to hold a group of QBarSets
     getNewBarSeries();
@@ -122,20 +141,9 @@ QtCharts::QChart* AgeChartHelper::getChart(std::vector<Agent*> *agents) {
 //******************************************************************************
 
 
-void AgeChartHelper::updateChart(std::vector<Agent *> *agents) {
-    // Iniailize a vector to store the count in each bucket
-    std::vector<int> counts(10, 0);
-
-    // Move through list of agents and increment the appriopriate count
-    for (size_t i = 0; i < agents->size(); ++i) {
-        int age = agents->at(i)->getAge();
-        int index = age / 10;
-        index = std::min(index, 9); // Remove this and make agents die when turning 100
-        counts[index]++;
-    }
-
+void AgeChartHelper::updateChart(const SimulationStats &stats) {
     // Initialize a QBarSet to store the set of bars for the graph
-    QList<qreal> count(counts.begin(), counts.end());
+    QList<qreal> count(stats.ageCounts.begin(), stats.ageCounts.end());
     QtCharts::QBarSet* barSet = getNewBarSet();
     barSet->append(count);
 }
@@ -245,10 +253,10 @@ BehaviorChartHelper::~BehaviorChartHelper() {
 //******************************************************************************
 
 
-QtCharts::QChart* BehaviorChartHelper::getChart(std::vector<Agent *> *agents, int numAdultBehaviors, int numChildBehaviors) {
+QtCharts::QChart* BehaviorChartHelper::getChart(const SimulationStats &stats) {
 
     // Create a new vector of QBarSets with the counts
-    updateChart(agents, numAdultBehaviors, numChildBehaviors);
+    updateChart(stats);
 
     // Create a QBarSeries to group the bars together
     getNewBarSeries();
@@ -270,19 +278,12 @@ QtCharts::QChart* BehaviorChartHelper::getChart(std::vector<Agent *> *agents, in
 //******************************************************************************
 
 
-void BehaviorChartHelper::updateChart(std::vector<Agent *> *agents, int numAdultBehaviors, int numChildBehaviors) {
-    // Initialize vectors to store the count of each behavior
-    std::vector<int> adultCounts(numAdultBehaviors, 0);
-    std::vector<int> childCounts(numChildBehaviors, 0);
-
-    // Count the number of agents that have each behavior
-    for (size_t i = 0; i < agents->size(); ++i) {
-        if (agents->at(i)->isAdult()) {
-            adultCounts[agents->at(i)->getBehavior()]++;
-        } else {
-            childCounts[agents->at(i)->getBehavior()]++;
-        }
-    }
+void BehaviorChartHelper::updateChart(const SimulationStats &stats) {
+    // Grab the number of agents that have each behavior
+    const std::vector<int>& adultCounts = stats.adultBehaviorCounts;
+    const std::vector<int>& childCounts = stats.childBehaviorCounts;
+    int numAdultBehaviors = static_cast<int>(adultCounts.size());
+    int numChildBehaviors = static_cast<int>(childCounts.size());
 
     // Create a QBarSet for each the adult and child counts
     std::vector<QtCharts::QBarSet*>* barCounts = getNewBarSets(std::max(numAdultBehaviors, numChildBehaviors));
@@ -393,9 +394,9 @@ DestinationChartHelper::~DestinationChartHelper() {
 //******************************************************************************
 
 
-QtCharts::QChart* DestinationChartHelper::getChart(std::vector<Agent *> *agents) {
+QtCharts::QChart* DestinationChartHelper::getChart(const SimulationStats &stats) {
     // Create an updated BarSet with counts
-    updateChart(agents);
+    updateChart(stats);
 
     // Initialize a QBarSeries to hold a group of QBarSets
     getNewBarSeries();
@@ -417,27 +418,14 @@ QtCharts::QChart* DestinationChartHelper::getChart(std::vector<Agent *> *agents)
 //******************************************************************************
 
 
-void DestinationChartHelper::updateChart(std::vector<Agent *> *agents) {
-
-    // Initialize a map to track the counts for each destination
-    std::unordered_map<QString, int> destinationCounts;
-    destinationCounts["Home"] = 0;
-    destinationCounts["Work"] = 0;
-    destinationCounts["School"] = 0;
-    destinationCounts["Leisure"] = 0;
-
-    // Update the count for each agent
-    for (size_t i = 0; i < agents->size(); ++i) {
-        QString destination = agents->at(i)->getDestinationString();
-        destinationCounts[destination]++;
-    }
+void DestinationChartHelper::updateChart(const SimulationStats &stats) {
 
     // Update the QBarSet
     QtCharts::QBarSet* bars = getNewBarSet();
-    bars->append(destinationCounts["Home"]);
-    bars->append(destinationCounts["Work"]);
-    bars->append(destinationCounts["School"]);
-    bars->append(destinationCounts["Leisure"]);
+    bars->append(stats.destinationCounts[Agent::HOME]);
+    bars->append(stats.destinationCounts[Agent::WORK]);
+    bars->append(stats.destinationCounts[Agent::SCHOOL]);
+    bars->append(stats.destinationCounts[Agent::LEISURE]);
 }
 
 
@@ -452,6 +440,70 @@ int roundToNearestHundred(double n) {
 //******************************************************************************
 
 
+int valueToBucket(int value, const std::vector<int>& thresholds) {
+    if (value == thresholds[0]) {
+        return 0;
+    } else if (value < thresholds[1]) {
+        return 1;
+    } else if (value < thresholds[2]) {
+        return 2;
+    } else if (value < thresholds[3]) {
+        return 3;
+    }
+    return 4;
+}
+
+
+//******************************************************************************
+
+
+ValueHistogram::ValueHistogram(const std::vector<int>* thresholds) {
+    this->thresholds = thresholds;
+    for (int i = 0; i < SimulationStats::NUM_VALUE_BUCKETS; ++i) {
+        counts[i] = 0;
+    }
+}
+
+
+//******************************************************************************
+
+
+int ValueHistogram::getBucket(int value) {
+    return valueToBucket(value, *thresholds);
+}
+
+
+//******************************************************************************
+
+
+void ValueHistogram::move(int from, int to) {
+    if (from == to) {
+        return;
+    }
+    if (from != -1) {
+        counts[from]--;
+    }
+    if (to != -1) {
+        counts[to]++;
+    }
+}
+
+
+//******************************************************************************
+
+
+std::vector<int> ValueHistogram::getCounts() {
+    std::vector<int> snapshot(SimulationStats::NUM_VALUE_BUCKETS);
+    for (int i = 0; i < SimulationStats::NUM_VALUE_BUCKETS; ++i) {
+        snapshot[i] = counts[i];
+    }
+    return snapshot;
+}
+
+
+//******************************************************************************
+
+
 QtCharts::QBarSet* AgentValueChartHelper::getNewBarSet() {
     if (barSet == nullptr) {
         barSet = new QtCharts::QBarSet("Counts");
@@ -515,7 +567,8 @@ QtCharts::QBarCategoryAxis* AgentValueChartHelper::getNewAxis() {
 //******************************************************************************
 
 
-AgentValueChartHelper::AgentValueChartHelper(int initialValue) {
+AgentValueChartHelper::AgentValueChartHelper(int initialValue) :
+    histogram(&thresholds) {
 
     // Initialze pointers to nullptr
     barSet = nullptr;
@@ -558,9 +611,9 @@ AgentValueChartHelper::~AgentValueChartHelper() {
 //******************************************************************************
 
 
-QtCharts::QChart* AgentValueChartHelper::getChart(std::vector<Agent *> *agents) {
+QtCharts::QChart* AgentValueChartHelper::getChart(const SimulationStats &stats) {
     // Create an updated BarSet with counts
-    updateChart(agents);
+    updateChart(stats);
 
     // Initialize a QBarSeries to hold a group of QBarSets
     getNewBarSeries();
@@ -582,30 +635,10 @@ QtCharts::QChart* AgentValueChartHelper::getChart(std::vector<Agent *> *agents)
 //******************************************************************************
 
 
-void AgentValueChartHelper::updateChart(std::vector<Agent *> *agents) {
-
-    // Initialize a map to track the counts for each destination
-    std::vector<int> valueCounts(5, 0);
-
-    // Update the count for each agent
-    for (size_t i = 0; i < agents->size(); ++i) {
-        EconomicAgent* agent = dynamic_cast<EconomicAgent*>(agents->at(i));
-        int agentValue = agent->getValue();
-
-        if (agentValue  == 0) {
-            valueCounts[0]++;
-        } else if (agentValue < thresholds[1]) {
-            valueCounts[1]++;
-        } else if (agentValue < thresholds[2]) {
-            valueCounts[2]++;
-        } else if (agentValue < thresholds[3]) {
-            valueCounts[3]++;
-        } else {
-            valueCounts[4]++;
-        }
-    }
+void AgentValueChartHelper::updateChart(const SimulationStats &stats) {
 
     // Update the QBarSet
+    const std::vector<int>& valueCounts = stats.agentValueCounts;
     QtCharts::QBarSet* bars = getNewBarSet();
     bars->append(valueCounts[0]);
     bars->append(valueCounts[1]);
@@ -626,6 +659,14 @@ std::vector<int>& AgentValueChartHelper::getThresholds() {
 //******************************************************************************
 
 
+ValueHistogram& AgentValueChartHelper::getHistogram() {
+    return this->histogram;
+}
+
+
+//******************************************************************************
+
+
 QtCharts::QBarSet* WorkValueChartHelper::getNewBarSet() {
     if (barSet == nullptr) {
         barSet = new QtCharts::QBarSet("Counts");
@@ -689,7 +730,8 @@ QtCharts::QBarCategoryAxis* WorkValueChartHelper::getNewAxis() {
 //******************************************************************************
 
 
-WorkValueChartHelper::WorkValueChartHelper(int initialValue) {
+WorkValueChartHelper::WorkValueChartHelper(int initialValue) :
+    histogram(&thresholds) {
 
     // Initialize pointers to nullptr
     barSet = nullptr;
@@ -731,9 +773,9 @@ WorkValueChartHelper::~WorkValueChartHelper() {
 //******************************************************************************
 
 
-QtCharts::QChart* WorkValueChartHelper::getChart(std::vector<Location*> *locations) {
+QtCharts::QChart* WorkValueChartHelper::getChart(const SimulationStats &stats) {
     // Create an updated BarSet with counts
-    updateChart(locations);
+    updateChart(stats);
 
     // Initialize a QBarSeries to hold a group of QBarSets
     getNewBarSeries();
@@ -755,30 +797,10 @@ QtCharts::QChart* WorkValueChartHelper::getChart(std::vector<Location*> *locatio
 //******************************************************************************
 
 
-void WorkValueChartHelper::updateChart(std::vector<Location*> *locations) {
-
-    // Initialize a map to track the counts for each destination
-    std::vector<int> valueCounts(5, 0);
-
-    // Update the count for each agent
-    for (size_t i = 0; i < locations->size(); ++i) {
-        EconomicLocation* location = dynamic_cast<EconomicLocation*>(locations->at(i));
-        int locationValue = location->getValue();
-
-        if (locationValue  == 0) {
-            valueCounts[0]++;
-        } else if (locationValue < thresholds[1]) {
-            valueCounts[1]++;
-        } else if (locationValue < thresholds[2]) {
-            valueCounts[2]++;
-        } else if (locationValue < thresholds[3]) {
-            valueCounts[3]++;
-        } else {
-            valueCounts[4]++;
-        }
-    }
+void WorkValueChartHelper::updateChart(const SimulationStats &stats) {
 
     // Update the QBarSet
+    const std::vector<int>& valueCounts = stats.businessValueCounts;
     QtCharts::QBarSet* bars = getNewBarSet();
     bars->append(valueCounts[0]);
     bars->append(valueCounts[1]);
@@ -799,6 +821,191 @@ std::vector<int>& WorkValueChartHelper::getThresholds() {
 //******************************************************************************
 
 
+ValueHistogram& WorkValueChartHelper::getHistogram() {
+    return this->histogram;
+}
+
+
+//******************************************************************************
+
+
+TimeSeries::TimeSeries(int pointBudget) {
+    this->pointBudget = std::max(pointBudget, 3);
+    this->bucketWidth = 0;
+    this->numDrawn = 0;
+}
+
+
+//******************************************************************************
+
+
+void TimeSeries::append(double value) {
+    history.push_back(static_cast<float>(value));
+}
+
+
+//******************************************************************************
+
+
+int TimeSeries::size() {
+    return static_cast<int>(history.size());
+}
+
+
+//******************************************************************************
+
+
+const std::vector<float>& TimeSeries::getHistory() const {
+    return this->history;
+}
+
+
+//******************************************************************************
+
+
+void TimeSeries::updateSeries(QtCharts::QLineSeries* series) {
+    if (history.empty()) {
+        return;
+    }
+
+    // Draw every point while the history fits within the budget
+    if (static_cast<int>(history.size()) <= pointBudget) {
+        series->append(history.size() - 1, history.back());
+        return;
+    }
+
+    // Redraw the whole series when the history first outgrows the budget, or
+    // when the buckets have to widen to fit
+    if (bucketWidth == 0 || getNumBuckets() > pointBudget - 2) {
+        rebucket();
+        QList<QPointF> points;
+        points.append(QPointF(0, history[0]));
+        points.append(finalized.toList());
+        points.append(getTail());
+        series->replace(points);
+        numDrawn = finalized.size();
+        return;
+    }
+
+    // Otherwise only the points after the last drawn finalized point change
+    finalizeBuckets();
+    int firstStale = 1 + numDrawn;
+    if (series->count() > firstStale) {
+        series->removePoints(firstStale, series->count() - firstStale);
+    }
+    QList<QPointF> points = finalized.mid(numDrawn).toList();
+    points.append(getTail());
+    series->append(points);
+    numDrawn = finalized.size();
+}
+
+
+//******************************************************************************
+
+
+int TimeSeries::getNumBuckets() {
+    int interior = static_cast<int>(history.size()) - 2;
+    return (interior + bucketWidth - 1) / bucketWidth;
+}
+
+
+//******************************************************************************
+
+
+QPointF TimeSeries::getBucketAverage(int bucket) {
+    int last = static_cast<int>(history.size()) - 1;
+    int start = 1 + bucket * bucketWidth;
+    int end = std::min(start + bucketWidth, last);
+    if (start >= end) {
+        return QPointF(last, history[last]);
+    }
+
+    double averageX = 0;
+    double averageY = 0;
+    for (int j = start; j < end; ++j) {
+        averageX += j;
+        averageY += history[j];
+    }
+    return QPointF(averageX / (end - start), averageY / (end - start));
+}
+
+
+//******************************************************************************
+
+
+QPointF TimeSeries::selectPoint(int bucket, QPointF previous, QPointF next) {
+    int start = 1 + bucket * bucketWidth;
+    int end = std::min(start + bucketWidth, static_cast<int>(history.size()) - 1);
+
+    // Keep the point in this bucket that forms the largest triangle with the
+    // previously kept point and the average of the next bucket
+    double maxArea = -1;
+    int selected = start;
+    for (int j = start; j < end; ++j) {
+        double area = std::abs((previous.x() - next.x()) * (history[j] - previous.y()) -
+                               (previous.x() - j) * (next.y() - previous.y()));
+        if (area > maxArea) {
+            maxArea = area;
+            selected = j;
+        }
+    }
+    return QPointF(selected, history[selected]);
+}
+
+
+//******************************************************************************
+
+
+void TimeSeries::rebucket() {
+    bucketWidth = std::max(bucketWidth, 1);
+    while (getNumBuckets() > pointBudget - 2) {
+        bucketWidth *= 2;
+    }
+
+    finalized.clear();
+    finalizeBuckets();
+}
+
+
+//******************************************************************************
+
+
+void TimeSeries::finalizeBuckets() {
+    // A bucket's point is fixed once the bucket after it is full
+    int numFull = (static_cast<int>(history.size()) - 2) / bucketWidth;
+    while (finalized.size() < numFull - 1) {
+        QPointF previous = finalized.isEmpty() ? QPointF(0, history[0]) : finalized.back();
+        finalized.append(selectPoint(finalized.size(), previous,
+                                     getBucketAverage(finalized.size() + 1)));
+    }
+}
+
+
+//******************************************************************************
+
+
+QList<QPointF> TimeSeries::getTail() {
+    QList<QPointF> tail;
+    int last = static_cast<int>(history.size()) - 1;
+    int numBuckets = getNumBuckets();
+
+    // The last bucket is followed by the last point rather than a bucket
+    QPointF previous = finalized.isEmpty() ? QPointF(0, history[0]) : finalized.back();
+    for (int bucket = finalized.size(); bucket < numBuckets; ++bucket) {
+        QPointF next = (bucket + 1 < numBuckets) ? getBucketAverage(bucket + 1)
+                                                 : QPointF(last, history[last]);
+        previous = selectPoint(bucket, previous, next);
+        tail.append(previous);
+    }
+
+    tail.append(QPointF(last, history[last]));
+    return tail;
+}
+
+
+//******************************************************************************
+
+
 QtCharts::QLineSeries* TotalValueChartHelper::getNewLineSeries() {
     if (lineSeries == nullptr) {
         lineSeries = new QLineSeries();
@@ -813,12 +1020,15 @@ QtCharts::QLineSeries* TotalValueChartHelper::getNewLineSeries() {
 QtCharts::QChart* TotalValueChartHelper::getNewChart() {
     if (chart == nullptr) {
         chart = new QtCharts::QChart();
-    }
 
-    chart->addSeries(lineSeries);
-    chart->addAxis(xAxis, Qt::AlignBottom);
-    chart->addAxis(yAxis, Qt::AlignLeft);
-    chart->setTitle("Total Value");
+        // The series and axes only need to be attached once
+        chart->addSeries(lineSeries);
+        chart->addAxis(xAxis, Qt::AlignBottom);
+        chart->addAxis(yAxis, Qt::AlignLeft);
+        lineSeries->attachAxis(xAxis);
+        lineSeries->attachAxis(yAxis);
+        chart->setTitle("Total Value");
+    }
 
     return chart;
 }
@@ -900,7 +1110,8 @@ void TotalValueChartHelper::updateChart(int totalValue) {
     if (lineSeries == nullptr) {
         getNewLineSeries();
     }
-    lineSeries->append(lineSeries->count(), totalValue);
+    totalHistory.append(totalValue);
+    totalHistory.updateSeries(lineSeries);
 
     // Update the axes to show the entire graph
     QValueAxis* y = getNewAxis("y");
@@ -910,17 +1121,17 @@ void TotalValueChartHelper::updateChart(int totalValue) {
     minimum = std::min(minimum, totalValue);
     maximum = std::max(maximum, totalValue);
     y->setRange(minimum - 100, maximum + 100);
-    lineSeries->attachAxis(y);
 
     // Update the range of the X-axis
-    x->setRange(0, lineSeries->count());
-    lineSeries->attachAxis(x);
+    x->setRange(0, totalHistory.size());
+}
 
-    // Add the new series to the chart
-    if (chart != nullptr) {
-        chart->addSeries(lineSeries);
-    }
 
+//******************************************************************************
+
+
+const std::vector<float>& TotalValueChartHelper::getHistory() const {
+    return totalHistory.getHistory();
 }
 
 
@@ -952,13 +1163,18 @@ QtCharts::QLineSeries* EconomicStatusChartHelper::getUnemployedLineSeries() {
 QtCharts::QChart* EconomicStatusChartHelper::getNewChart() {
     if (chart == nullptr) {
         chart = new QtCharts::QChart();
-    }
 
-    chart->addSeries(homelessLineSeries);
-    chart->addSeries(employmentLineSeries);
-    chart->addAxis(xAxis, Qt::AlignBottom);
-    chart->addAxis(yAxis, Qt::AlignLeft);
-    chart->setTitle("Agent Economic Status");
+        // The series and axes only need to be attached once
+        chart->addSeries(homelessLineSeries);
+        chart->addSeries(employmentLineSeries);
+        chart->addAxis(xAxis, Qt::AlignBottom);
+        chart->addAxis(yAxis, Qt::AlignLeft);
+        homelessLineSeries->attachAxis(xAxis);
+        homelessLineSeries->attachAxis(yAxis);
+        employmentLineSeries->attachAxis(xAxis);
+        employmentLineSeries->attachAxis(yAxis);
+        chart->setTitle("Agent Economic Status");
+    }
 
     return chart;
 }
@@ -1056,29 +1272,29 @@ void EconomicStatusChartHelper::updateChart(double homelessCount, double unemplo
     double unemployedProportion = unemployedCount / numAgents;
 
     // Add new values to each line series
-    homelessLineSeries->append(homelessLineSeries->count(), homelessProportion);
-    employmentLineSeries->append(employmentLineSeries->count(), unemployedProportion);
+    homelessHistory.append(homelessProportion);
+    unemployedHistory.append(unemployedProportion);
+    homelessHistory.updateSeries(homelessLineSeries);
+    unemployedHistory.updateSeries(employmentLineSeries);
 
     // Update the axes to show the entire graph
     QValueAxis* y = getNewAxis("y");
     QValueAxis* x = getNewAxis("x");
 
-    // Update the range of the Y-axis
+    // Update the range of each axis
     y->setRange(0, 1);
-    homelessLineSeries->attachAxis(y);
-    employmentLineSeries->attachAxis(y);
+    x->setRange(0, homelessHistory.size());
+}
 
-    // Update the range of the X-axis
-    x->setRange(0, homelessLineSeries->count());
-    homelessLineSeries->attachAxis(x);
-    employmentLineSeries->attachAxis(x);
 
-    // Add the new series to the chart
-    if (chart != nullptr) {
-        chart->addSeries(homelessLineSeries);
-        chart->addSeries(employmentLineSeries);
-    }
+//******************************************************************************
+
 
+const std::vector<float>& EconomicStatusChartHelper::getHistory(QString which) const {
+    if (which == "Homeless") {
+        return homelessHistory.getHistory();
+    }
+    return unemployedHistory.getHistory();
 }
 
 
@@ -1119,15 +1335,19 @@ QtCharts::QLineSeries* SEIRChartHelper::getLineSeries(QString which) {
 QtCharts::QChart* SEIRChartHelper::getNewChart() {
     if (chart == nullptr) {
         chart = new QtCharts::QChart();
-    }
 
-    chart->addSeries(susceptibleLineSeries);
-    chart->addSeries(exposedLineSeries);
-    chart->addSeries(infectedLineSeries);
-    chart->addSeries(recoveredLineSeries);
-    chart->addAxis(xAxis, Qt::AlignBottom);
-    chart->addAxis(yAxis, Qt::AlignLeft);
-    chart->setTitle("Agent Pandemic Status");
+        // The series and axes only need to be attached once
+        QList<QLineSeries*> allSeries = {susceptibleLineSeries, exposedLineSeries,
+                                         infectedLineSeries, recoveredLineSeries};
+        chart->addAxis(xAxis, Qt::AlignBottom);
+        chart->addAxis(yAxis, Qt::AlignLeft);
+        for (QLineSeries* series : allSeries) {
+            chart->addSeries(series);
+            series->attachAxis(xAxis);
+            series->attachAxis(yAxis);
+        }
+        chart->setTitle("Agent Pandemic Status");
+    }
 
     return chart;
 }
@@ -1229,37 +1449,37 @@ void SEIRChartHelper::updateChart(std::vector<int> SEIRAgents, int numAgents) {
     double recoveredProportion = SEIRAgents[PandemicAgent::RECOVERED] / static_cast<double>(numAgents);
 
     // Add new values to each line series
-    susceptibleLineSeries->append(susceptibleLineSeries->count(), susceptibleProportion);
-    exposedLineSeries->append(exposedLineSeries->count(), exposedProportion);
-    infectedLineSeries->append(infectedLineSeries->count(), infectedProportion);
-    recoveredLineSeries->append(recoveredLineSeries->count(), recoveredProportion);
+    susceptibleHistory.append(susceptibleProportion);
+    exposedHistory.append(exposedProportion);
+    infectedHistory.append(infectedProportion);
+    recoveredHistory.append(recoveredProportion);
+    susceptibleHistory.updateSeries(susceptibleLineSeries);
+    exposedHistory.updateSeries(exposedLineSeries);
+    infectedHistory.updateSeries(infectedLineSeries);
+    recoveredHistory.updateSeries(recoveredLineSeries);
 
     // Update the axes to show the entire graph
     QValueAxis* y = getNewAxis("y");
     QValueAxis* x = getNewAxis("x");
 
-    // Update the range of the Y-axis
+    // Update the range of each axis
     y->setRange(0, 1);
-    susceptibleLineSeries->attachAxis(y);
-    exposedLineSeries->attachAxis(y);
-    infectedLineSeries->attachAxis(y);
-    recoveredLineSeries->attachAxis(y);
+    x->setRange(0, susceptibleHistory.size());
+}
 
-    // Update the range of the X-axis
-    x->setRange(0, susceptibleLineSeries->count());
-    susceptibleLineSeries->attachAxis(x);
-    exposedLineSeries->attachAxis(x);
-    infectedLineSeries->attachAxis(x);
-    recoveredLineSeries->attachAxis(x);
 
-    // Add the new series to the chart
-    if (chart != nullptr) {
-        chart->addSeries(susceptibleLineSeries);
-        chart->addSeries(exposedLineSeries);
-        chart->addSeries(infectedLineSeries);
-        chart->addSeries(recoveredLineSeries);
-    }
+//******************************************************************************
+
 
+const std::vector<float>& SEIRChartHelper::getHistory(QString which) const {
+    if (which == "Susceptible") {
+        return susceptibleHistory.getHistory();
+    } else if (which == "Exposed") {
+        return exposedHistory.getHistory();
+    } else if (which == "Infected") {
+        return infectedHistory.getHistory();
+    }
+    return recoveredHistory.getHistory();
 }
 
 
@@ -0,0 +1,172 @@
+#include "Headers/Currency.h"
+
+Currency::Currency() {
+    this->units = 0;
+}
+
+
+//******************************************************************************
+
+
+Currency::Currency(int whole) {
+    this->units = static_cast<long long>(whole) * UNITS_PER_WHOLE;
+}
+
+
+//******************************************************************************
+
+
+Currency Currency::fromDouble(double amount) {
+    return fromUnits(std::llround(amount * UNITS_PER_WHOLE));
+}
+
+
+//******************************************************************************
+
+
+Currency Currency::fromUnits(long long units) {
+    Currency amount;
+    amount.units = units;
+    return amount;
+}
+
+
+//******************************************************************************
+
+
+long long Currency::getUnits() const {
+    return this->units;
+}
+
+
+//******************************************************************************
+
+
+int Currency::toInt() const {
+    return static_cast<int>(units / UNITS_PER_WHOLE);
+}
+
+
+//******************************************************************************
+
+
+double Currency::toDouble() const {
+    return static_cast<double>(units) / UNITS_PER_WHOLE;
+}
+
+
+//******************************************************************************
+
+
+Currency Currency::scaledBy(double factor) const {
+    return fromUnits(std::llround(static_cast<double>(units) * factor));
+}
+
+
+//******************************************************************************
+
+
+Currency Currency::multipliedBy(long long count) const {
+    return fromUnits(units * count);
+}
+
+
+//******************************************************************************
+
+
+Currency Currency::dividedBy(long long count) const {
+    return fromUnits(units / count);
+}
+
+
+//******************************************************************************
+
+
+Currency Currency::operator+(const Currency &other) const {
+    return fromUnits(units + other.units);
+}
+
+
+//******************************************************************************
+
+
+Currency Currency::operator-(const Currency &other) const {
+    return fromUnits(units - other.units);
+}
+
+
+//******************************************************************************
+
+
+Currency Currency::operator-() const {
+    return fromUnits(-units);
+}
+
+
+//******************************************************************************
+
+
+Currency& Currency::operator+=(const Currency &other) {
+    this->units += other.units;
+    return *this;
+}
+
+
+//******************************************************************************
+
+
+Currency& Currency::operator-=(const Currency &other) {
+    this->units -= other.units;
+    return *this;
+}
+
+
+//******************************************************************************
+
+
+bool Currency::operator==(const Currency &other) const {
+    return units == other.units;
+}
+
+
+//******************************************************************************
+
+
+bool Currency::operator!=(const Currency &other) const {
+    return units != other.units;
+}
+
+
+//******************************************************************************
+
+
+bool Currency::operator<(const Currency &other) const {
+    return units < other.units;
+}
+
+
+//******************************************************************************
+
+
+bool Currency::operator>(const Currency &other) const {
+    return units > other.units;
+}
+
+
+//******************************************************************************
+
+
+bool Currency::operator<=(const Currency &other) const {
+    return units <= other.units;
+}
+
+
+//******************************************************************************
+
+
+bool Currency::operator>=(const Currency &other) const {
+    return units >= other.units;
+}
+
+
+//******************************************************************************
@@ -8,7 +8,9 @@ DualController::DualController(Simulation* sim) :
     PandemicController(sim),
     EconomicController(sim) {
 
-    agentRedistributedValue = 0;
+    agentRedistributedValue = Currency();
+    perCapitaPayout = Currency();
+    undistributedPayout = Currency();
 };
 
 
@@ -20,9 +22,6 @@ void DualController::updateAgentDestinations(std::vector<Agent *> &agents, int h
     // Acquire the Locations lock to avoid race conditions
     QMutexLocker locationsLock(getLocationLock());
 
-    // Initialize the number of deaths this hour
-    int numHourlyDeaths = 0;
-
     // Initialize all values needed for the Pandemic update
     initializePandemicUpdate(agents);
 
@@ -31,29 +30,38 @@ void DualController::updateAgentDestinations(std::vector<Agent *> &agents, int h
 
     // Perform the Pandemic and Economic updates for every agent
     locationsLock.unlock();
-    double businessRedistributedValue = 0;
-    agentRedistributedValue = 0;
+    Currency businessRedistributedValue;
+    agentRedistributedValue = Currency();
     QMutexLocker agentLock(getAgentLock());
 
     std::vector<PandemicAgent*> pandemicAgents = getPandemicAgents();
+
+    // Decide which Infected Agents die this hour before anyone is removed
+    std::vector<int> deaths = evaluateMortality(pandemicAgents);
+    std::vector<bool> died(agents.size(), false);
+    for (size_t i = 0; i < deaths.size(); ++i) {
+        died[deaths[i]] = true;
+    }
+
+    // The Dual update stays on one thread, but collects its changes to
+    // businesses and locations the same way the parallel Economic update does
+    std::vector<EconomicShard> shards = createShards(agents.size(), false);
     for (int i = static_cast<int>(agents.size()) - 1; i >= 0; --i) {
         // Update each Agents location according to their Behavior Chart
         updateSingleDestination(agents[i], hour, true);
 
-        DualAgent* dualAgent = dynamic_cast<DualAgent*>(pandemicAgents[i]);
-        int agentValue = dualAgent->getValue();
-        bool died = agentPandemicUpdate(pandemicAgents[i], static_cast<int>(i));
-        if (died) {
-            agentRedistributedValue += agentValue;
-            pandemicAgents[i] = nullptr;
-            numHourlyDeaths++;
+        if (died[i]) {
+            agentRedistributedValue += dynamic_cast<DualAgent*>(pandemicAgents[i])->getBalance();
         } else {
-            businessRedistributedValue += agentEconomicUpdate(dynamic_cast<EconomicAgent*>(agents[i]));
+            businessRedistributedValue += agentEconomicUpdate(dynamic_cast<EconomicAgent*>(agents[i]),
+                                                              static_cast<size_t>(i), shards[0]);
         }
     }
+    resolveShards(shards);
 
-    // Update the state of the Simulation
-    killAgents(numHourlyDeaths);
+    // Remove every Agent that died and update the state of the Simulation
+    applyMortality(pandemicAgents, deaths);
+    killAgents(static_cast<int>(deaths.size()));
 
     // Spread the Infection to new Agents
     spreadInfection(pandemicAgents);
@@ -133,7 +141,7 @@ void DualController::businessEconomicUpdate(int hour) {
                     }
 
                     // Decrease the work locations value by the additional overhead
-                    workLocation->incrementValue(-1 * std::ceil(additionalOverhead * workOverhead));
+                    workLocation->incrementValue(Currency::fromDouble(-1 * std::ceil(additionalOverhead * workOverhead)));
                 }
 
             }
@@ -145,7 +153,7 @@ void DualController::businessEconomicUpdate(int hour) {
 //******************************************************************************
 
 
-double DualController::homeEconomicUpdate(EconomicAgent *agent) {
+Currency DualController::homeEconomicUpdate(EconomicAgent *agent, size_t index, EconomicShard &shard) {
 
     // Get the simulation
     DualSimulation* sim = dynamic_cast<DualSimulation*>(getSim());
@@ -153,7 +161,7 @@ double DualController::homeEconomicUpdate(EconomicAgent *agent) {
 
     // Prevent infected homeless agents from moving into new homes if any sort
     // of lockdown is in effect
-    double returnValue = 0;
+    Currency returnValue;
     if (agent->getStatus() == EconomicAgent::HOMELESS ||
             agent->getStatus() == EconomicAgent::BOTH) {
 
@@ -167,13 +175,13 @@ double DualController::homeEconomicUpdate(EconomicAgent *agent) {
             if (dualAgent->PandemicAgent::getStatus() != PandemicAgent::EXPOSED &&
                     dualAgent->PandemicAgent::getStatus() != PandemicAgent::INFECTED) {
                 // Call the base EconomicController::homeEconomicUpdate function
-                returnValue = EconomicController::homeEconomicUpdate(agent);
+                returnValue = EconomicController::homeEconomicUpdate(agent, index, shard);
             }
         }
     } else {
 
         // Call the base EconomicController::homeEconomicUpdate function
-        returnValue = EconomicController::homeEconomicUpdate(agent);
+        returnValue = EconomicController::homeEconomicUpdate(agent, index, shard);
     }
 
     // If there is government assistance, give unemployed agents some value
@@ -182,12 +190,13 @@ double DualController::homeEconomicUpdate(EconomicAgent *agent) {
                 agent->getStatus() == EconomicAgent::BOTH) {
             if (agent->canReceiveUnemployment()) {
                 agent->incrementHoursOfUnemployment();
+                int roll = getRandomRoll(shard.seed, index, 4);
                 if (sim->checkDebug("strong assistance")) {
-                    agent->incrementValue(rand() % 3 == 0);
+                    agent->incrementValue(roll % 3 == 0);
                 } else if (sim->checkDebug("moderate assistance")) {
-                    agent->incrementValue(rand() % 5 == 0);
+                    agent->incrementValue(roll % 5 == 0);
                 } else if (sim->checkDebug("weak assistance")) {
-                    agent->incrementValue(rand() % 8 == 0);
+                    agent->incrementValue(roll % 8 == 0);
                 }
             }
         }
@@ -213,13 +222,13 @@ double DualController::homeEconomicUpdate(EconomicAgent *agent) {
 //******************************************************************************
 
 
-void DualController::workEconomicUpdate(EconomicAgent *agent) {
+void DualController::workEconomicUpdate(EconomicAgent *agent, size_t index, EconomicShard &shard) {
 
     // Get the simulation
     DualSimulation* sim = dynamic_cast<DualSimulation*>(getSim());
 
     // Call the base EconomicSimulation::workEconomicUpdate function
-    EconomicController::workEconomicUpdate(agent);
+    EconomicController::workEconomicUpdate(agent, index, shard);
 
     // If there is government assistance, give unemployed agents some value
     if (agent->getStatus() == EconomicAgent::UNEMPLOYED ||
@@ -243,63 +252,54 @@ void DualController::workEconomicUpdate(EconomicAgent *agent) {
 //******************************************************************************
 
 
-void DualController::lockdownLocations() {
+void DualController::updateLockdownStatus(PandemicLocation* pandemicLocation, LOCKDOWN policy) {
 
-    // Update every Location if Lockdowns are enforced
-    PandemicSimulation* sim = dynamic_cast<PandemicSimulation*>(getSim());
-    std::vector<Location*> locations = sim->getAllLocations();
-    for (size_t i = 0; i < locations.size(); ++i) {
-        // Get the Location and calculate the infected proportion
-        DualLocation* location = dynamic_cast<DualLocation*>(locations[i]);
-        double infectedProportion = location->getNumAgents() > 0 ?
-                    static_cast<double>(location->getNumInfectedAgents()) / location->getNumAgents() :
-                    0;
+    // Get the Location and calculate the infected proportion
+    DualLocation* location = dynamic_cast<DualLocation*>(pandemicLocation);
+    if (location == nullptr) {
+        return;
+    }
+    double infectedProportion = location->getNumAgents() > 0 ?
+                static_cast<double>(location->getNumInfectedAgents()) / location->getNumAgents() :
+                0;
 
-        // Home locations cannot go on lockdown
-        if (location->PandemicLocation::getType() == Agent::HOME) {
-            continue;
-        }
+    // Home locations cannot go on lockdown
+    if (location->PandemicLocation::getType() == Agent::HOME) {
+        return;
+    }
 
-        // If it's a leisure location and it's sibling is locked down,
-        // automatically lock down also
-        DualLocation* sibling = dynamic_cast<DualLocation*>(location->getSibling());
-        if (location->PandemicLocation::getType() == Agent::LEISURE &&
-                sibling != nullptr && sibling->PandemicLocation::getStatus() == PandemicLocation::LOCKDOWN) {
-            location->setStatus(PandemicLocation::LOCKDOWN);
-            continue;
-        }
+    // If it's a leisure location and it's sibling is locked down,
+    // automatically lock down also
+    DualLocation* sibling = dynamic_cast<DualLocation*>(location->getSibling());
+    PandemicLocation::STATUS previousStatus = location->PandemicLocation::getStatus();
+    if (location->PandemicLocation::getType() == Agent::LEISURE &&
+            sibling != nullptr && sibling->PandemicLocation::getStatus() == PandemicLocation::LOCKDOWN) {
+        location->setStatus(PandemicLocation::LOCKDOWN);
+        return;
+    }
 
-        // If all of the Agents at the Location are Infected, immediately lockdown
-//        if (infectedProportion == 1) {
-//            location->setStatus(PandemicLocation::LOCKDOWN);
-//            continue;
-//        }
+    // If all of the Agents at the Location are Infected, immediately lockdown
+//    if (infectedProportion == 1) {
+//        location->setStatus(PandemicLocation::LOCKDOWN);
+//        return;
+//    }
 
-        if (sim->checkDebug("total lockdown")) {
-            location->setStatus(PandemicLocation::LOCKDOWN);
-            continue;
-        } else if (sim->checkDebug("strong lockdown")) {
-            if (infectedProportion > 0.20) {
-                location->setStatus(PandemicLocation::LOCKDOWN);
-                continue;
-            }
-        } else if (sim->checkDebug("moderate lockdown")) {
-            if (infectedProportion > 0.35) {
-                location->setStatus(PandemicLocation::LOCKDOWN);
-                continue;
-            }
-        } else if (sim->checkDebug("weak lockdown")) {
-            if (infectedProportion > 0.75) {
-                location->setStatus(PandemicLocation::LOCKDOWN);
-                continue;
-            }
-        }
+    if (policy == TOTAL_LOCKDOWN) {
+        location->setStatus(PandemicLocation::LOCKDOWN);
+    } else if (policy != NO_LOCKDOWN && infectedProportion > getLockdownThreshold(policy)) {
+        location->setStatus(PandemicLocation::LOCKDOWN);
+    } else if (location->getNumInfectedAgents() > 0) {
+        location->setStatus(PandemicLocation::EXPOSURE);
+    } else {
+        location->setStatus(PandemicLocation::NORMAL);
+    }
 
-        if (location->getNumInfectedAgents() > 0) {
-            location->setStatus(PandemicLocation::EXPOSURE);
-        } else {
-            location->setStatus(PandemicLocation::NORMAL);
-        }
+    // The leisure sibling of a business follows it in and out of lockdown
+    bool wasLockedDown = (previousStatus == PandemicLocation::LOCKDOWN);
+    bool isLockedDown = (location->PandemicLocation::getStatus() == PandemicLocation::LOCKDOWN);
+    if (location->PandemicLocation::getType() == Agent::WORK &&
+            sibling != nullptr && wasLockedDown != isLockedDown) {
+        locationChanged(sibling);
     }
 }
 
@@ -350,6 +350,8 @@ void DualController::makeHomeless(EconomicAgent *agent) {
 
     // Update the numInfectedAgents count for the Agent's current home location
     DualLocation* currentHome = dynamic_cast<DualLocation*>(agent->getLocation(Agent::HOME));
+    agent->logEvent(EventLog::HOMELESS, currentHome != nullptr ? currentHome->getID() : -1,
+                    agent->getBalance().getUnits());
 
     if (dualAgent != nullptr && currentHome != nullptr) {
         if (dualAgent->PandemicAgent::getStatus() == PandemicAgent::INFECTED) {
@@ -365,58 +367,51 @@ void DualController::makeHomeless(EconomicAgent *agent) {
 //******************************************************************************
 
 
-void DualController::finishEconomicUpdate(double redistributedValue, QString type) {
+void DualController::removeAgent(Agent* victim) {
+    PandemicController::removeAgent(victim);
+    EconomicController::removeAgent(victim);
+}
+
+
+//******************************************************************************
+
+
+void DualController::finishEconomicUpdate(Currency redistributedValue, QString type) {
 
     DualSimulation* sim = dynamic_cast<DualSimulation*>(getSim());
 
     // Track how many hours since the last new business was generated, new
     // businesses can only appear once every 24 hours
-    static int lastNewBusiness = 0;
     lastNewBusiness += 1;
 
     // If there are less than the initial amount of businesses, have a chance
     // to generate a new business and leisure location
-    std::vector<Location*> workLocations = sim->getRegion(Agent::WORK)->getLocations();
-    if (static_cast<int>(workLocations.size()) < sim->getUI()->numLocations->value()) {
-        if (rand() % 5 == 0 && lastNewBusiness > (7 * 24)) {
+    if (getNumOpenBusinesses() < sim->getNumLocations()) {
+        if (sim->getRandom() % 5 == 0 && lastNewBusiness > (7 * 24)) {
             generateNewBusiness(type);
             lastNewBusiness = 0;
         }
     }
 
-    // Distribute the value lost from agents at home equally to each business
-    int openBusinesses = 0;
-    std::vector<Location*> locations = sim->getRegion(Agent::WORK)->getLocations();
-
-    // Count the number of business that are opened
-    for (size_t i = 0; i < locations.size(); ++i) {
-        DualLocation* location = dynamic_cast<DualLocation*>(locations[i]);
-        if (location->PandemicLocation::getStatus() != PandemicLocation::LOCKDOWN) {
-            openBusinesses++;
-        }
-    }
-
-    // If there are no open businesses, don't distribute any value
-    if (openBusinesses == 0) {
+    // Distribute the value lost from agents at home equally to each open
+    // business. Businesses on lockdown leave the ledger's shareholders, so
+    // if there are no open businesses, don't distribute any value
+    if (!ledger.distribute(redistributedValue)) {
         finishEconomicState();
         return;
     }
-
-    // Distribute the value to each Open business
     setTotalBusinessValue(getTotalBusinessValue() + redistributedValue);
-    for (size_t i = 0; i < locations.size(); ++i) {
-        DualLocation* location = dynamic_cast<DualLocation*>(locations[i]);
-        if (location->PandemicLocation::getStatus() != PandemicLocation::LOCKDOWN) {
-            location->incrementValue(redistributedValue / openBusinesses);
-        }
-    }
 
-    // Distribute the value from dead agents to other agents
+    // Distribute the value from dead agents to other agents. Each Agent
+    // collects its share from the running payout when its value is read, and
+    // the remainder of the split waits for the next payout
     setTotalAgentValue(getTotalAgentValue() + agentRedistributedValue);
-    std::vector<Agent*> agents = sim->getAgents();
-    for (size_t i = 0; i < agents.size(); ++i) {
-        DualAgent* agent = dynamic_cast<DualAgent*>(agents[i]);
-        agent->incrementValue(agentRedistributedValue / agents.size());
+    size_t numAgents = sim->getAgents().size();
+    if (agentRedistributedValue != Currency() && numAgents > 0) {
+        Currency total = agentRedistributedValue + undistributedPayout;
+        Currency share = total.dividedBy(static_cast<long long>(numAgents));
+        perCapitaPayout += share;
+        undistributedPayout = total - share.multipliedBy(static_cast<long long>(numAgents));
     }
 
     // Update the economic state of the Simulation
@@ -426,3 +421,11 @@ void DualController::finishEconomicUpdate(double redistributedValue, QString typ
 
 //******************************************************************************
 
+
+const Currency* DualController::getPerCapitaPayout() {
+    return &perCapitaPayout;
+}
+
+
+//******************************************************************************
+
@@ -1,10 +1,22 @@
 #include "Headers/DualLocation.h"
 
-DualLocation::DualLocation(double x, double y, Agent::LOCATIONS type) :
+DualLocation::DualLocation(double x, double y, Agent::LOCATIONS type, int costRoll) :
     Location(x, y),
     PandemicLocation(x, y, type),
-    EconomicLocation(x, y, type) {
+    EconomicLocation(x, y, type, costRoll) {
 };
 
 
+//******************************************************************************
+
+
+void DualLocation::statusChanged(PandemicLocation::STATUS previousStatus) {
+    bool wasLockedDown = (previousStatus == PandemicLocation::LOCKDOWN);
+    bool isLockedDown = (PandemicLocation::getStatus() == PandemicLocation::LOCKDOWN);
+    if (wasLockedDown != isLockedDown) {
+        setReceivingValue(!isLockedDown);
+    }
+}
+
+
 //******************************************************************************
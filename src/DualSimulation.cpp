@@ -4,32 +4,38 @@
 
 DualSimulation::DualSimulation(int lagPeriod, int initialInfected, int initialValue,
                                int numAgents, Ui::MainWindow* ui,
-                               std::map<std::string, bool> debug, PolicyNetwork* network) :
-    PandemicSimulation(lagPeriod, initialInfected, initialValue, numAgents, ui, debug),
-    indexPolicyMapping({
-                       {0, ui->quarantineWhenInfected},
-                       {1, ui->totalLockdown},
-                       {2, ui->weak},
-                       {3, ui->moderate},
-                       {4, ui->strong},
-                       {5, ui->weakLockdown},
-                       {6, ui->moderateLockdown},
-                       {7, ui->strongLockdown},
-                       {8, ui->weakAssistance},
-                       {9, ui->moderateAssistance},
-                       {10, ui->strongAssistance},
-                       {11, ui->weakGuidelines},
-                       {12, ui->moderateGuidelines},
-                       {13, ui->strongGuidelines},
-                       {14, ui->weakCommerce},
-                       {15, ui->moderateCommerce},
-                       {16, ui->strongCommerce}
-                   }) {
+                               std::map<std::string, bool> debug, PolicyNetwork* network,
+                               const SimulationSettings* settings) :
+    PandemicSimulation(lagPeriod, initialInfected, initialValue, numAgents, ui, debug, settings) {
+
+    // The network chooses policies by checking their boxes on the UI
+    if (ui != nullptr) {
+        indexPolicyMapping = {
+            {0, ui->quarantineWhenInfected},
+            {1, ui->totalLockdown},
+            {2, ui->weak},
+            {3, ui->moderate},
+            {4, ui->strong},
+            {5, ui->weakLockdown},
+            {6, ui->moderateLockdown},
+            {7, ui->strongLockdown},
+            {8, ui->weakAssistance},
+            {9, ui->moderateAssistance},
+            {10, ui->strongAssistance},
+            {11, ui->weakGuidelines},
+            {12, ui->moderateGuidelines},
+            {13, ui->strongGuidelines},
+            {14, ui->weakCommerce},
+            {15, ui->moderateCommerce},
+            {16, ui->strongCommerce}
+        };
+    }
 
     // Update the Agent Controller to a Dual Controller
     PandemicSimulation::setAgentController(new DualController(static_cast<PandemicSimulation*>(this)));
 
     this->network = network;
+    this->numFrames = 0;
 }
 
 
@@ -37,19 +43,23 @@ DualSimulation::DualSimulation(int lagPeriod, int initialInfected, int initialVa
 
 
 void DualSimulation::execute() {
-    // Static counter to determine if an hour has passed
-    static int numFrames = 0;
-
     // Run the Pandemic Simulation's execute function
     PandemicSimulation::execute();
 
+    // Keep the frame counter in step if the whole hour was fast-forwarded
+    if (wasFastForwarded()) {
+        numFrames = FRAMES_PER_HOUR;
+    }
+
     // Update the overall values
     EconomicController* econController = dynamic_cast<EconomicController*>(getController());
-    setBusinessEconomicValue(econController->getTotalBusinessValue());
-    setTotalEconomicValue(econController->getTotalBusinessValue() + econController->getTotalAgentValue());
+    setBusinessEconomicValue(econController->getTotalBusinessValue().toInt());
+    setTotalEconomicValue(econController->getTotalBusinessValue().toInt() + econController->getTotalAgentValue().toInt());
 
     // Update the current value displayed on the screen
-    getUI()->currentValue->setText(QString::number(getTotalEconomicValue()));
+    if (getUI() != nullptr) {
+        getUI()->currentValue->setText(QString::number(getTotalEconomicValue()));
+    }
 
     // Every hour update the Economic Charts
     if (numFrames == FRAMES_PER_HOUR) {
@@ -86,6 +96,22 @@ void DualSimulation::generateAgents(int num, bool birth, std::string) {
     // EconomicSimulation::generateAgents takes care of everything needed
     // for the Dual Simulation
     EconomicSimulation::generateAgents(num, birth, "Dual");
+
+    // Tie each new agent to the payout from Agents that die. New agents only
+    // receive payouts made after they were created
+    DualController* controller = dynamic_cast<DualController*>(getController());
+    if (controller == nullptr) {
+        return;
+    }
+    QMutexLocker lock(getAgentsLock());
+    std::vector<Agent*>& agents = getAgents();
+    size_t numNew = std::min(agents.size(), static_cast<size_t>(num));
+    for (size_t i = agents.size() - numNew; i < agents.size(); ++i) {
+        EconomicAgent* agent = dynamic_cast<EconomicAgent*>(agents[i]);
+        if (agent != nullptr) {
+            agent->setPerCapitaPayout(controller->getPerCapitaPayout());
+        }
+    }
 }
 
 
@@ -152,7 +178,7 @@ void DualSimulation::renderAgentUpdate() {
 
 void DualSimulation::renderCharts(const QString &which, bool newChartView) {
 
-    if (getUI()->headlessMode->checkState() == Qt::CheckState::Checked) {
+    if (isHeadless()) {
         return;
     }
 
@@ -1,14 +1,23 @@
 #include "Headers/EconomicAgent.h"
+#include "Headers/ChartHelpers.h"
 
 EconomicAgent::EconomicAgent(int initialValue, int age, Location* startingLocation,
                              QString startingLocationString, int behavior) :
     Agent(age, startingLocation, startingLocationString, behavior) {
 
     // Give the agent some initial economic value
-    this->economicValue = initialValue;
+    this->economicValue = Currency(initialValue);
     this->currentStatus = NORMAL;
     this->hoursOfEmployment = 0;
     this->hoursOfUnemployment = 0;
+
+    // Value buckets are only tracked once a histogram has been provided
+    this->valueHistogram = nullptr;
+    this->valueBucket = -1;
+
+    // Agents only receive payouts once tied to one
+    this->perCapitaPayout = nullptr;
+    this->payoutAtEntry = Currency();
 }
 
 
@@ -16,8 +25,10 @@ EconomicAgent::EconomicAgent(int initialValue, int age, Location* startingLocati
 
 
 int EconomicAgent::incrementValue(int amount) {
-    this->economicValue += amount;
-    return economicValue;
+    settlePayout();
+    this->economicValue += Currency(amount);
+    updateValueBucket();
+    return getValue();
 }
 
 
@@ -25,8 +36,10 @@ int EconomicAgent::incrementValue(int amount) {
 
 
 int EconomicAgent::decrementValue(int amount) {
-    this->economicValue = std::max(economicValue - amount, 0);
-    return economicValue;
+    settlePayout();
+    this->economicValue = std::max(economicValue - Currency(amount), Currency());
+    updateValueBucket();
+    return getValue();
 }
 
 
@@ -34,6 +47,17 @@ int EconomicAgent::decrementValue(int amount) {
 
 
 int EconomicAgent::getValue() {
+    return getBalance().toInt();
+}
+
+
+//******************************************************************************
+
+
+Currency EconomicAgent::getBalance() {
+    if (perCapitaPayout != nullptr) {
+        return this->economicValue + (*perCapitaPayout - payoutAtEntry);
+    }
     return this->economicValue;
 }
 
@@ -84,4 +108,71 @@ bool EconomicAgent::canReceiveUnemployment() {
 }
 
 
+//******************************************************************************
+
+
+void EconomicAgent::setValueHistogram(ValueHistogram* histogram) {
+    // Take the Agent out of its previous histogram
+    if (valueHistogram != nullptr) {
+        valueHistogram->move(valueBucket, -1);
+    }
+    this->valueBucket = -1;
+    this->valueHistogram = histogram;
+    updateValueBucket();
+}
+
+
+//******************************************************************************
+
+
+int EconomicAgent::getValueBucket() {
+    // Payouts reach the Agent without touching it, so check for a bucket
+    // change whenever the bucket is read
+    if (perCapitaPayout != nullptr) {
+        updateValueBucket();
+    }
+    return this->valueBucket;
+}
+
+
+//******************************************************************************
+
+
+void EconomicAgent::setPerCapitaPayout(const Currency* payout) {
+    settlePayout();
+    this->perCapitaPayout = payout;
+    this->payoutAtEntry = (payout != nullptr) ? *payout : Currency();
+}
+
+
+//******************************************************************************
+
+
+void EconomicAgent::settlePayout() {
+    if (perCapitaPayout == nullptr) {
+        return;
+    }
+    this->economicValue += (*perCapitaPayout - payoutAtEntry);
+    this->payoutAtEntry = *perCapitaPayout;
+}
+
+
+//******************************************************************************
+
+
+void EconomicAgent::updateValueBucket() {
+    if (valueHistogram == nullptr) {
+        return;
+    }
+
+    // Only mark the agent dirty when its value crosses a threshold
+    int newBucket = valueHistogram->getBucket(getValue());
+    if (newBucket != valueBucket) {
+        valueHistogram->move(valueBucket, newBucket);
+        this->valueBucket = newBucket;
+        markDirty();
+    }
+}
+
+
 //******************************************************************************
@@ -5,10 +5,11 @@
 EconomicController::EconomicController(Simulation* sim) :
     AgentController(sim) {
     this->sim = dynamic_cast<EconomicSimulation*>(sim);
-    agentValue = 0;
-    businessValue = 0;
+    agentValue = Currency();
+    businessValue = Currency();
     changeInValue = std::deque<double>(24, 0);
-    previousValue = 0;
+    previousValue = Currency();
+    lastNewBusiness = 0;
 }
 
 
@@ -24,16 +25,35 @@ void EconomicController::updateAgentDestinations(std::vector<Agent *> &agents, i
     businessEconomicUpdate(hour);
 
     // AGENT UPDATES ***********************************************************
-    // Loop through every agent
-    double redistributedValue = 0;
+    // Update each Agents location according to their Behavior Chart
     QMutexLocker agentLock(sim->getAgentsLock());
-
     for (size_t i = 0; i < agents.size(); ++i) {
-        // Update each Agents location according to their Behavior Chart
         updateSingleDestination(agents[i], hour, true);
-        redistributedValue += agentEconomicUpdate(dynamic_cast<EconomicAgent*>(agents[i]));
     }
 
+    // Update the value of every agent, one shard per thread for large
+    // populations. Changes to businesses and locations wait in the shards
+    std::vector<EconomicShard> shards = createShards(agents.size(), true);
+    auto updateShard = [this, &agents](EconomicShard &shard) {
+        for (size_t i = shard.begin; i < shard.end; ++i) {
+            shard.redistributedValue += agentEconomicUpdate(dynamic_cast<EconomicAgent*>(agents[i]), i, shard);
+        }
+    };
+
+    if (shards.size() == 1) {
+        updateShard(shards[0]);
+    } else {
+        QtConcurrent::blockingMap(shards, updateShard);
+    }
+
+    // Apply the changes each shard collected. Currency sums exactly, so the
+    // total does not depend on how the agents were split
+    Currency redistributedValue;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        redistributedValue += shards[i].redistributedValue;
+    }
+    resolveShards(shards);
+
     // CLEAN UP ****************************************************************
     finishEconomicUpdate(redistributedValue);
 }
@@ -42,65 +62,164 @@ void EconomicController::updateAgentDestinations(std::vector<Agent *> &agents, i
 //******************************************************************************
 
 
+std::vector<EconomicController::EconomicShard> EconomicController::createShards(size_t numAgents, bool parallel) {
+
+    // Draw a single seed for the hour
+    unsigned long long seed = (static_cast<unsigned long long>(sim->getRandom()) << 32) ^
+                              static_cast<unsigned long long>(sim->getRandom());
+
+    // Split the agents into up to one shard per thread, as long as every
+    // shard has enough agents to be worth running on its own thread
+    size_t numShards = 1;
+    if (parallel) {
+        size_t numThreads = static_cast<size_t>(std::max(1, QThreadPool::globalInstance()->maxThreadCount()));
+        numShards = std::max(static_cast<size_t>(1), std::min(numThreads, numAgents / ECONOMY_SHARD_MIN));
+    }
+    size_t shardSize = (numAgents + numShards - 1) / numShards;
+    std::vector<EconomicShard> shards(numShards);
+    for (size_t i = 0; i < numShards; ++i) {
+        shards[i].begin = std::min(i * shardSize, numAgents);
+        shards[i].end = std::min((i + 1) * shardSize, numAgents);
+        shards[i].seed = seed;
+        shards[i].agentValue = Currency();
+        shards[i].redistributedValue = Currency();
+    }
+    return shards;
+}
+
+
+//******************************************************************************
+
+
+void EconomicController::resolveShards(std::vector<EconomicShard> &shards) {
+
+    // Apply the value each agent gave to or took from a business
+    for (size_t i = 0; i < shards.size(); ++i) {
+        agentValue += shards[i].agentValue;
+        for (size_t j = 0; j < shards[i].valueChanges.size(); ++j) {
+            ValueChange &change = shards[i].valueChanges[j];
+
+            // Pay each worker in turn while the business can afford it. If the
+            // business is unable to pay a worker, it goes bankrupt. A business
+            // is only queued once, no matter how many workers it couldn't pay
+            if (change.worker != nullptr) {
+                if (change.business->getValue() <= Currency::fromDouble(change.business->getCost())) {
+                    bankruptBusiness(change.business);
+                    continue;
+                }
+                Currency previousBalance = change.worker->getBalance();
+                change.worker->incrementValue(change.business->getCost());
+                agentValue += change.worker->getBalance() - previousBalance;
+            }
+
+            change.business->incrementValue(change.amount);
+            businessValue = std::max(businessValue + change.amount, Currency());
+        }
+    }
+
+    // Each business hires at most one applicant a day, the first to apply
+    for (size_t i = 0; i < shards.size(); ++i) {
+        for (size_t j = 0; j < shards[i].applications.size(); ++j) {
+            JobApplication &application = shards[i].applications[j];
+            bool canHire = application.business->makeHire();
+            if (canHire && application.accept) {
+                application.agent->setLocation(application.business, Agent::WORK);
+                application.business->addAgent(application.agent);
+                application.agent->logEvent(EventLog::HIRE, application.business->getID());
+
+                // Update the status of the Agent
+                if (application.agent->getStatus() == EconomicAgent::BOTH) {
+                    application.agent->setStatus(EconomicAgent::HOMELESS);
+                } else {
+                    application.agent->setStatus(EconomicAgent::NORMAL);
+                }
+            }
+        }
+    }
+
+    // Move homeless agents into the homes they found, and make homeless the
+    // agents that couldn't pay for theirs
+    for (size_t i = 0; i < shards.size(); ++i) {
+        for (size_t j = 0; j < shards[i].homeOffers.size(); ++j) {
+            HomeOffer &offer = shards[i].homeOffers[j];
+            offer.agent->setLocation(offer.home, Agent::HOME);
+            offer.home->addAgent(offer.agent);
+
+            // Update the Agent's status as appriopriate
+            if (offer.agent->getStatus() == EconomicAgent::BOTH) {
+                offer.agent->setStatus(EconomicAgent::UNEMPLOYED);
+            } else {
+                offer.agent->setStatus(EconomicAgent::NORMAL);
+            }
+        }
+        for (size_t j = 0; j < shards[i].evictions.size(); ++j) {
+            makeHomeless(shards[i].evictions[j]);
+        }
+    }
+}
+
+
+//******************************************************************************
+
+
 void EconomicController::businessEconomicUpdate(int hour) {
     // Reset the business and agent values
     previousValue = businessValue + agentValue;
-    if (previousValue == 0) {
-        previousValue = sim->getCurrentValue();
+    if (previousValue == Currency()) {
+        previousValue = Currency(sim->getCurrentValue());
     }
 //    double temp = previousValue;
 //    qDebug() << QString::number(temp);
-    businessValue = 0;
-    agentValue = 0;
+    businessValue = Currency();
+    agentValue = Currency();
 
-    // Update each Location in the Simulation
-    std::vector<Location*> workLocations = sim->getRegion(Agent::WORK)->getLocations();
-    for (int i = static_cast<int>(workLocations.size()) - 1; i >= 0; --i) {
-        EconomicLocation* workLocation = dynamic_cast<EconomicLocation*>(workLocations[i]);
+    // Reset every business's counters for the current day
+    if (hour == 0) {
+        ledger.startNewDay();
+    }
 
-        // Reset the Locations counter for the current day
-        if (hour == 0) {
-            workLocation->startNewDay();
-        }
+    // Have each business pay an overhead during the day
+    int currentHour = sim->getHour();
+    if (currentHour > 7 && currentHour < 20) {
+        ledger.applyOverhead(Currency(workOverhead));
+    }
 
-        // Have each business pay an overhead during the day
-        int currentHour = sim->getHour();
-        if (currentHour > 7 && currentHour < 20) {
-            workLocation->incrementValue(-1 * workOverhead);
-        }
+    // If a business runs out of money, it becomes bankrupt
+    std::vector<EconomicLocation*> candidates = ledger.getBankruptcyCandidates();
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        bankruptBusiness(candidates[i]);
+    }
 
-        // Add the businesses value to the total
-        businessValue += workLocation->getValue();
+    // Close the bankrupt businesses and open the new ones before any agent
+    // is updated this hour
+    applyBusinessTurnover();
 
-        // If a business runs out of money, it becomes bankrupt
-        if (workLocation->getValue() == 0) {
-            bankruptBusiness(workLocation);
-        }
-    }
+    // Add the businesses value to the total
+    businessValue += ledger.getTotalValue();
 }
 
 
 //******************************************************************************
 
 
-double EconomicController::agentEconomicUpdate(EconomicAgent* agent) {
+Currency EconomicController::agentEconomicUpdate(EconomicAgent* agent, size_t index, EconomicShard &shard) {
 
     QString currentDestinaton = agent->getDestinationString();
-    double redistributedValue = 0;
+    Currency redistributedValue;
 
     // Update the Agent according to its current location
     if (currentDestinaton == "Home") {
-        redistributedValue = homeEconomicUpdate(agent);
+        redistributedValue = homeEconomicUpdate(agent, index, shard);
     } else if (currentDestinaton == "School") {
         schoolEconomicUpdate(agent);
     } else if (currentDestinaton == "Work") {
-        workEconomicUpdate(agent);
+        workEconomicUpdate(agent, index, shard);
     } else if (currentDestinaton == "Leisure") {
-        leisureEconomicUpdate(agent);
+        leisureEconomicUpdate(agent, index, shard);
     }
 
     // Add the agent's value to the total
-    agentValue += agent->getValue();
+    shard.agentValue += agent->getBalance();
 
     // Return the redistributed value
     return redistributedValue;
@@ -110,30 +229,26 @@ double EconomicController::agentEconomicUpdate(EconomicAgent* agent) {
 //******************************************************************************
 
 
-void EconomicController::finishEconomicUpdate(double redistributedValue, QString type) {
+void EconomicController::finishEconomicUpdate(Currency redistributedValue, QString type) {
 
     // Track how many hours since the last new business was generated, new
     // businesses can only appear once every 24 hours
-    static int lastNewBusiness = 0;
     lastNewBusiness += 1;
 
     // If there are less than the initial amount of businesses, have a chance
     // to generate a new business and leisure location
-    std::vector<Location*> workLocations = sim->getRegion(Agent::WORK)->getLocations();
-    if (static_cast<int>(workLocations.size()) < sim->getUI()->numLocations->value()) {
-        if (rand() % 5 == 0 && lastNewBusiness > 24) {
+    if (getNumOpenBusinesses() < sim->getNumLocations()) {
+        if (sim->getRandom() % 5 == 0 && lastNewBusiness > 24) {
             generateNewBusiness(type);
             lastNewBusiness = 0;
         }
     }
 
-    // Distribute the value lost from agents at home equally to each business
-    std::vector<Location*> locations = sim->getRegion(Agent::WORK)->getLocations();
+    // Distribute the value lost from agents at home equally to each business.
+    // The ledger adds it to a running dividend that each business collects
+    // the next time its value is touched
     businessValue += redistributedValue;
-    for (size_t i = 0; i < locations.size(); ++i) {
-        EconomicLocation* location = dynamic_cast<EconomicLocation*>(locations[i]);
-        location->incrementValue(redistributedValue / locations.size());
-    }
+    ledger.distribute(redistributedValue);
 }
 
 
@@ -147,28 +262,103 @@ void EconomicController::bankruptBusiness(EconomicLocation *victim) {
         return;
     }
 
-    // Grab the agents from the Business and Leisure location
-    std::unordered_set<Agent*> employees = victim->getAgents();
-    std::unordered_set<Agent*> customers = victim->getSibling()->getAgents();
+    // Queue the business to close, once. It stops receiving redistributed
+    // value straight away, as it would have if it closed immediately
+    if (std::find(pendingClosures.begin(), pendingClosures.end(), victim) == pendingClosures.end()) {
+        pendingClosures.push_back(victim);
+        victim->setReceivingValue(false);
+    }
+}
+
+
+//******************************************************************************
 
-    // Mark each of the employee agents as unemployeed
-    for (auto it = employees.begin(); it != employees.end(); ++it) {
-        EconomicAgent* agent = dynamic_cast<EconomicAgent*>(*it);
-        makeUnemployed(agent);
+
+void EconomicController::applyBusinessTurnover() {
+    if (pendingClosures.empty() && pendingOpenings.empty()) {
+        return;
+    }
+
+    QMutexLocker agentLock(sim->getAgentsLock());
+
+    closeBusinesses();
+    if (pendingOpenings.empty()) {
+        return;
+    }
+
+    // Find the unemployed agents and the agents without a leisure location in
+    // a single pass, and share them between every new business
+    std::vector<Agent*> &agents = sim->getAgents();
+    std::vector<EconomicAgent*> unemployed;
+    std::vector<Agent*> withoutLeisure;
+    for (size_t i = 0; i < agents.size(); ++i) {
+        EconomicAgent* agent = dynamic_cast<EconomicAgent*>(agents[i]);
+        if (agent->getStatus() == EconomicAgent::BOTH || agent->getStatus() == EconomicAgent::UNEMPLOYED) {
+            unemployed.push_back(agent);
+        }
+        if (agents[i]->getLocation(Agent::LEISURE) == nullptr) {
+            withoutLeisure.push_back(agents[i]);
+        }
     }
 
-    // Remove the Leisure location
-    sim->getRegion(Agent::LEISURE)->removeLocation(victim->getSibling());
+    for (size_t i = 0; i < pendingOpenings.size(); ++i) {
+        createBusiness(pendingOpenings[i], unemployed, withoutLeisure);
+    }
+    pendingOpenings.clear();
+}
+
+
+//******************************************************************************
 
-    // Remove the Business location
-    sim->getRegion(Agent::WORK)->removeLocation(victim);
 
-    // Reassign each customer to a new leisure location
-    for (auto it = customers.begin(); it != customers.end(); ++it) {
-        Location* newLocation = sim->getRandomLocation(Agent::LEISURE);
-        (*it)->setLocation(newLocation, Agent::LEISURE);
+int EconomicController::getNumOpenBusinesses() {
+    return static_cast<int>(sim->getRegion(Agent::WORK)->getLocations().size() -
+                            pendingClosures.size() + pendingOpenings.size());
+}
+
+
+//******************************************************************************
+
+
+void EconomicController::closeBusinesses() {
+    std::vector<Location*> closedWork;
+    std::vector<Location*> closedLeisure;
+    std::vector<Agent*> customers;
+
+    for (size_t i = 0; i < pendingClosures.size(); ++i) {
+        EconomicLocation* victim = pendingClosures[i];
+        sim->logEvent(EventLog::BANKRUPTCY, -1, victim->getID(), victim->getValue().getUnits());
+
+        // Mark each of the employee agents as unemployeed
+        const std::unordered_set<Agent*> &employees = victim->getAgentSet();
+        for (auto it = employees.begin(); it != employees.end(); ++it) {
+            makeUnemployed(dynamic_cast<EconomicAgent*>(*it));
+        }
+
+        // Hold on to the customers until every leisure location has closed
+        const std::unordered_set<Agent*> &visitors = victim->getSibling()->getAgentSet();
+        customers.insert(customers.end(), visitors.begin(), visitors.end());
+
+        // Take the business out of the ledger and the value histogram
+        ledger.removeBusiness(victim);
+        victim->setValueHistogram(nullptr);
+
+        closedWork.push_back(victim);
+        closedLeisure.push_back(victim->getSibling());
+    }
+    pendingClosures.clear();
+
+    // Remove every closed location from its Region at once
+    sim->getRegion(Agent::LEISURE)->removeLocations(closedLeisure);
+    sim->getRegion(Agent::WORK)->removeLocations(closedWork);
+
+    // Reassign each customer to one of the leisure locations that remain
+    const std::vector<Location*> &leisure = sim->getRegion(Agent::LEISURE)->getLocations();
+    for (size_t i = 0; i < customers.size(); ++i) {
+        Location* newLocation = leisure.empty() ? nullptr : leisure[sim->getRandom() % leisure.size()];
+        customers[i]->setLocation(newLocation, Agent::LEISURE);
         if (newLocation != nullptr) {
-            (*it)->getLocation(Agent::LEISURE)->addAgent(*it);
+            newLocation->addAgent(customers[i]);
         }
     }
 }
@@ -177,12 +367,69 @@ void EconomicController::bankruptBusiness(EconomicLocation *victim) {
 //******************************************************************************
 
 
+void EconomicController::openBusiness(EconomicLocation *location) {
+    ledger.addBusiness(location);
+}
+
+
+//******************************************************************************
+
+
+void EconomicController::indexHomes(const std::vector<Location*> &homes) {
+    homesByCost.clear();
+    for (size_t i = 0; i < homes.size(); ++i) {
+        EconomicLocation* home = dynamic_cast<EconomicLocation*>(homes[i]);
+        if (home != nullptr) {
+            homesByCost.push_back(home);
+        }
+    }
+
+    // Keep homes with the same cost in their original order
+    std::stable_sort(homesByCost.begin(), homesByCost.end(),
+                     [](EconomicLocation* a, EconomicLocation* b) {
+        return a->getCost() < b->getCost();
+    });
+
+    homeCosts.resize(homesByCost.size());
+    for (size_t i = 0; i < homesByCost.size(); ++i) {
+        homeCosts[i] = homesByCost[i]->getCost();
+    }
+}
+
+
+//******************************************************************************
+
+
+int EconomicController::getNumAffordableHomes(int value) {
+    double limit = value / 2.0;
+    return static_cast<int>(std::lower_bound(homeCosts.begin(), homeCosts.end(), limit) - homeCosts.begin());
+}
+
+
+//******************************************************************************
+
+
+void EconomicController::removeAgent(Agent* victim) {
+    EconomicAgent* agent = dynamic_cast<EconomicAgent*>(victim);
+    if (agent != nullptr) {
+        agent->setValueHistogram(nullptr);
+    }
+}
+
+
+//******************************************************************************
+
+
 void EconomicController::makeHomeless(EconomicAgent *agent) {
     // Agent's can't become homeless on Day 1
     if (sim->getDay() == 0) {
         return;
     }
 
+    Location* home = agent->getLocation(Agent::HOME);
+    agent->logEvent(EventLog::HOMELESS, home != nullptr ? home->getID() : -1,
+                    agent->getBalance().getUnits());
+
     // Updates the Agent's status and location
     if (agent->getStatus() == EconomicAgent::UNEMPLOYED) {
         agent->setStatus(EconomicAgent::BOTH);
@@ -203,6 +450,10 @@ void EconomicController::makeUnemployed(EconomicAgent *agent) {
         return;
     }
 
+    Location* work = agent->getLocation(Agent::WORK);
+    agent->logEvent(EventLog::UNEMPLOYED, work != nullptr ? work->getID() : -1,
+                    agent->getBalance().getUnits());
+
     if (agent->getStatus() == EconomicAgent::HOMELESS) {
         agent->setStatus(EconomicAgent::BOTH);
     } else {
@@ -215,28 +466,24 @@ void EconomicController::makeUnemployed(EconomicAgent *agent) {
 //******************************************************************************
 
 
-double EconomicController::homeEconomicUpdate(EconomicAgent *agent) {
+Currency EconomicController::homeEconomicUpdate(EconomicAgent *agent, size_t index, EconomicShard &shard) {
 
     // Handle agents that are homeless
     EconomicAgent::STATUS status = agent->getStatus();
     if (status == EconomicAgent::HOMELESS || status == EconomicAgent::BOTH) {
 
-        // Given Homeless agents a small chance to get a home back if they can afford it
-        if (rand() % 100 < 10) {
-            EconomicLocation* potentialHome = dynamic_cast<EconomicLocation*>(sim->getRandomLocation(Agent::HOME));
-            if (agent->getValue() > 2 * potentialHome->getCost()) {
-                agent->setLocation(potentialHome, Agent::HOME);
-                potentialHome->addAgent(agent);
-
-                // Update the Agent's status as appriopriate
-                if (status == EconomicAgent::BOTH) {
-                    agent->setStatus(EconomicAgent::UNEMPLOYED);
-                } else {
-                    agent->setStatus(EconomicAgent::NORMAL);
-                }
+        // Given Homeless agents a small chance to get a home back if they can
+        // afford it. The agent tries a random home, and because the homes are
+        // sorted by cost, any roll below the number of affordable homes lands
+        // on one the agent can afford. The move happens when the shards are
+        // resolved at the end of the hour.
+        if (getRandomRoll(shard.seed, index, 0) % 100 < 10 && !homesByCost.empty()) {
+            size_t attempt = getRandomRoll(shard.seed, index, 1) % homesByCost.size();
+            if (attempt < static_cast<size_t>(getNumAffordableHomes(agent->getValue()))) {
+                shard.homeOffers.push_back({agent, homesByCost[attempt]});
             }
         }
-        return 0;
+        return Currency();
     }
 
     // Grab the current Location the agent is at
@@ -247,15 +494,15 @@ double EconomicController::homeEconomicUpdate(EconomicAgent *agent) {
         agent->decrementValue(currentLocation->getCost());
 
         // Distribute a portion of the agent's lost value to each business location
-        return currentLocation->getCost() * homeLossProportion;
+        return Currency::fromDouble(currentLocation->getCost() * homeLossProportion);
 
     } else if (agent->isAdult()) {
         // If the agent is an adult without enough money to pay, they become homeless
         // Children will never become homeless (simplifying assumption)
-        makeHomeless(agent);
+        shard.evictions.push_back(agent);
     }
 
-    return 0;
+    return Currency();
 }
 
 
@@ -273,35 +520,33 @@ void EconomicController::schoolEconomicUpdate(EconomicAgent *agent) {
 //******************************************************************************
 
 
-void EconomicController::workEconomicUpdate(EconomicAgent *agent) {
+void EconomicController::workEconomicUpdate(EconomicAgent *agent, size_t index, EconomicShard &shard) {
 
     // Handle agents that are unemployed
     EconomicAgent::STATUS status = agent->EconomicAgent::getStatus();
     if (status == EconomicAgent::UNEMPLOYED || status == EconomicAgent::BOTH) {
         // Give agent a chance to gain a small amount of value
-        if (rand() % 100 < 20) {
-            agent->incrementValue(rand() % 5 + 1);
+        if (getRandomRoll(shard.seed, index, 0) % 100 < 20) {
+            agent->incrementValue(getRandomRoll(shard.seed, index, 1) % 5 + 1);
         }
 
-        // Give agent a small chance of finding a new job
-        EconomicLocation* newPotentialJob = dynamic_cast<EconomicLocation*>(sim->getRandomLocation(Agent::WORK));
-        if (newPotentialJob == nullptr) {
+        // Give agent a small chance of finding a new job. The agent tries a
+        // random business, but only businesses with a vacancy can hire, so
+        // the roll is matched against the vacancies and every other business
+        // is a missed attempt
+        if (ledger.size() == 0) {
             return;
         }
-        bool canHire = newPotentialJob->makeHire();
-
-        // If the location can hire an agent, give them a 50% chance of getting the job
-        if (canHire && rand() % 2 == 0) {
-            agent->setLocation(newPotentialJob, Agent::WORK);
-            newPotentialJob->addAgent(agent);
-
-            // Update the status of the Agent
-            if (agent->getStatus() == EconomicAgent::BOTH) {
-                agent->setStatus(EconomicAgent::HOMELESS);
-            } else {
-                agent->setStatus(EconomicAgent::NORMAL);
-            }
+        size_t attempt = getRandomRoll(shard.seed, index, 2) % ledger.size();
+        if (attempt >= static_cast<size_t>(ledger.getNumVacancies())) {
+            return;
         }
+        EconomicLocation* newPotentialJob = ledger.getVacancy(static_cast<int>(attempt));
+
+        // If the location can hire an agent, give them a 50% chance of getting
+        // the job. Whether it can hire is decided once every application is in
+        bool accept = (getRandomRoll(shard.seed, index, 3) % 2 == 0);
+        shard.applications.push_back({agent, newPotentialJob, accept});
 
         // Agent will not have a chance to get value until the next hour
         return;
@@ -310,24 +555,17 @@ void EconomicController::workEconomicUpdate(EconomicAgent *agent) {
     // Grab the current Location the agent is at
     EconomicLocation* currentLocation = dynamic_cast<EconomicLocation*>(agent->getCurrentLocation());
 
-    // Agents gain value from being at work
-    if (currentLocation->getValue() > currentLocation->getCost()) {
-        agent->incrementValue(currentLocation->getCost());
-
-        // A portion of value gained by agents is lost from the business
-        currentLocation->incrementValue(-1 * workLossProportion * currentLocation->getCost());
-        businessValue = std::max(0.0, businessValue - (workLossProportion * currentLocation->getCost()));
-    } else {
-        // If the business is unable to pay it's workers, it goes bankrupt
-        bankruptBusiness(currentLocation);
-    }
+    // Agents gain value from being at work, and a portion of value gained by
+    // agents is lost from the business. Whether the business can pay is
+    // decided once every worker's claim is in
+    shard.valueChanges.push_back({currentLocation, Currency::fromDouble(-1 * workLossProportion * currentLocation->getCost()), agent});
 }
 
 
 //******************************************************************************
 
 
-void EconomicController::leisureEconomicUpdate(EconomicAgent *agent) {
+void EconomicController::leisureEconomicUpdate(EconomicAgent *agent, size_t index, EconomicShard &shard) {
 
     // Need to be extra careful getting location
     EconomicLocation* currentLocation = nullptr;
@@ -343,13 +581,12 @@ void EconomicController::leisureEconomicUpdate(EconomicAgent *agent) {
 
     // Homeless agents spend less money at leisure locations
     if (agent->getStatus() == EconomicAgent::BOTH || agent->getStatus() == EconomicAgent::HOMELESS) {
-        if (rand() % 2 == 0) {
+        if (getRandomRoll(shard.seed, index, 0) % 2 == 0) {
             agent->decrementValue(1);
 
             // The value lost by agents is given back to the business
             EconomicLocation* sibling = dynamic_cast<EconomicLocation*>(currentLocation->getSibling());
-            sibling->incrementValue(currentLocation->getCost());
-            businessValue += currentLocation->getCost();
+            shard.valueChanges.push_back({sibling, Currency::fromDouble(currentLocation->getCost()), nullptr});
         }
         return;
     }
@@ -360,8 +597,7 @@ void EconomicController::leisureEconomicUpdate(EconomicAgent *agent) {
 
         // The value lost by agents is given back to the business
         EconomicLocation* sibling = dynamic_cast<EconomicLocation*>(currentLocation->getSibling());
-        sibling->incrementValue(currentLocation->getCost());
-        businessValue += currentLocation->getCost();
+        shard.valueChanges.push_back({sibling, Currency::fromDouble(currentLocation->getCost()), nullptr});
     }
 }
 
@@ -370,6 +606,15 @@ void EconomicController::leisureEconomicUpdate(EconomicAgent *agent) {
 
 
 void EconomicController::generateNewBusiness(QString type) {
+    pendingOpenings.push_back(type);
+}
+
+
+//******************************************************************************
+
+
+void EconomicController::createBusiness(QString type, std::vector<EconomicAgent*> &unemployed,
+                                        std::vector<Agent*> &withoutLeisure) {
 
     // Generate a new work and leisure location
     sim->getRegion(Agent::WORK)->generateLocations(1, type.toStdString());
@@ -384,27 +629,27 @@ void EconomicController::generateNewBusiness(QString type) {
     newLeisure->setSibling(newWork);
 
     // Render the new locations to the screen
-    sim->addToAddQueue(newWork->getGraphicsObject());
-    sim->addToAddQueue(newLeisure->getGraphicsObject());
+    sim->addToAddQueue(QVector<QGraphicsItem*>({newWork->getGraphicsObject(),
+                                                newLeisure->getGraphicsObject()}));
 
     // Give the new work location some amount of value
-    newWork->incrementValue(rand() % 200 + 500);
+    openBusiness(newWork);
+    newWork->setValueHistogram(&sim->getBusinessHistogram());
+    newWork->incrementValue(Currency(sim->getRandom() % 200 + 500));
+    sim->logEvent(EventLog::NEW_BUSINESS, -1, newWork->getID(), newWork->getValue().getUnits());
 
     // Grab the agents in the Simulation
-    std::vector<Agent*> agents = sim->getAgents();
-
-    // Assign agents to the new Work Location
-    int unemployedAgents = sim->getNumUnemployedAgents();
+    std::vector<Agent*> &agents = sim->getAgents();
 
     // If there are unemployed agents, assign up to five of them to work at
     // the new location
-    if (unemployedAgents > 0) {
-        int newAgents = std::min(5, unemployedAgents);
-        std::vector<Agent*> unemployedAgents = sim->getUnemployedAgents();
-        for (int i = 0; i < newAgents; ++i) {
-            EconomicAgent* agent = dynamic_cast<EconomicAgent*>(unemployedAgents[i]);
+    if (!unemployed.empty()) {
+        size_t newAgents = std::min(static_cast<size_t>(5), unemployed.size());
+        for (size_t i = 0; i < newAgents; ++i) {
+            EconomicAgent* agent = unemployed[i];
             agent->setLocation(newWork, Agent::WORK);
             newWork->addAgent(agent);
+            agent->logEvent(EventLog::HIRE, newWork->getID());
 
             // Update the status of the agent
             if (agent->getStatus() == EconomicAgent::BOTH) {
@@ -413,12 +658,13 @@ void EconomicController::generateNewBusiness(QString type) {
                 agent->setStatus(EconomicAgent::NORMAL);
             }
         }
+        unemployed.erase(unemployed.begin(), unemployed.begin() + static_cast<long>(newAgents));
 
     } else {
         // Otherwise, select a small number of employed agents to work there
         int newAgents = std::min(3, static_cast<int>(agents.size()));
         for (int i = 0; i < newAgents; ++i) {
-            EconomicAgent* agent = dynamic_cast<EconomicAgent*>(agents[rand() % agents.size()]);
+            EconomicAgent* agent = dynamic_cast<EconomicAgent*>(agents[sim->getRandom() % agents.size()]);
 
             // Remove the agent from their previous work location
             Location* previousLocation = agent->getLocation(Agent::WORK);
@@ -429,23 +675,22 @@ void EconomicController::generateNewBusiness(QString type) {
             // Give the Agent a new work location
             agent->setLocation(newWork, Agent::WORK);
             newWork->addAgent(agent);
+            agent->logEvent(EventLog::HIRE, newWork->getID());
         }
     }
 
     // Assign all agents with no leisure location to this new location
-    int count = 0;
-    for (size_t i = 0; i < agents.size(); ++i) {
-        if (agents[i]->getLocation(Agent::LEISURE) == nullptr) {
-            agents[i]->setLocation(newLeisure, Agent::LEISURE);
-            newLeisure->addAgent(agents[i]);
-            count++;
-        }
+    int count = static_cast<int>(withoutLeisure.size());
+    for (size_t i = 0; i < withoutLeisure.size(); ++i) {
+        withoutLeisure[i]->setLocation(newLeisure, Agent::LEISURE);
+        newLeisure->addAgent(withoutLeisure[i]);
     }
+    withoutLeisure.clear();
 
     // Add additional agents to the new Leisure location to reach enough agents
-    int newAgents = std::min(std::max((rand() % 10 + 3) - count, 0), static_cast<int>(agents.size()));
+    int newAgents = std::min(std::max((sim->getRandom() % 10 + 3) - count, 0), static_cast<int>(agents.size()));
     for (int i = 0; i < newAgents; ++i) {
-        EconomicAgent* agent = dynamic_cast<EconomicAgent*>(agents[rand() % agents.size()]);
+        EconomicAgent* agent = dynamic_cast<EconomicAgent*>(agents[sim->getRandom() % agents.size()]);
 
         // Remove the agent from their previous leisure location
         Location* previousLocation = agent->getLocation(Agent::LEISURE);
@@ -463,7 +708,7 @@ void EconomicController::generateNewBusiness(QString type) {
 //******************************************************************************
 
 
-int EconomicController::getTotalAgentValue() {
+Currency EconomicController::getTotalAgentValue() {
     return this->agentValue;
 }
 
@@ -471,7 +716,7 @@ int EconomicController::getTotalAgentValue() {
 //******************************************************************************
 
 
-int EconomicController::getTotalBusinessValue() {
+Currency EconomicController::getTotalBusinessValue() {
     return this->businessValue;
 }
 
@@ -479,7 +724,7 @@ int EconomicController::getTotalBusinessValue() {
 //******************************************************************************
 
 
-void EconomicController::setTotalAgentValue(int newValue) {
+void EconomicController::setTotalAgentValue(Currency newValue) {
     this->agentValue = newValue;
 }
 
@@ -487,7 +732,7 @@ void EconomicController::setTotalAgentValue(int newValue) {
 //******************************************************************************
 
 
-void EconomicController::setTotalBusinessValue(int newValue) {
+void EconomicController::setTotalBusinessValue(Currency newValue) {
     this->businessValue = newValue;
 }
 
@@ -510,7 +755,7 @@ void EconomicController::finishEconomicState() {
 //    qDebug() << QString::number(agentValue);
 //    qDebug() << QString::number(businessValue);
 //    qDebug() << QString::number(previousValue);
-    double percentChange = 100 * (((agentValue + businessValue) / static_cast<double>(previousValue)) - 1.0);
+    double percentChange = 100 * (((agentValue + businessValue).toDouble() / previousValue.toDouble()) - 1.0);
     changeInValue.pop_front();
     changeInValue.push_back(percentChange);
 }
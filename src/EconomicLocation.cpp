@@ -1,15 +1,20 @@
 #include "Headers/EconomicLocation.h"
+#include "Headers/ChartHelpers.h"
 
-EconomicLocation::EconomicLocation(double x, double y, Agent::LOCATIONS type) :
+EconomicLocation::EconomicLocation(double x, double y, Agent::LOCATIONS type, int costRoll) :
     Location(x, y) {
 
-    this->value = 0;
-    this->dailyValueChange = 0;
-    this->yesterdayValueChange = 0;
+    this->value = Currency();
+    this->dailyValueChange = Currency();
+    this->yesterdayValueChange = Currency();
     this->sibling = nullptr;
     this->type = type;
     this->totalDays = 0;
     this->dailyHire = false;
+    this->valueHistogram = nullptr;
+    this->valueBucket = -1;
+    this->ledger = nullptr;
+    this->ledgerIndex = -1;
 
     // Home locations have a cost between [1, 3]
     if (type == Agent::HOME) {
@@ -20,10 +25,10 @@ EconomicLocation::EconomicLocation(double x, double y, Agent::LOCATIONS type) :
         this->cost = 1;
     } else if (type == Agent::WORK) {
         // Work locations have a cost of [5, 10]
-        this->cost = (rand() % 2) + 5;
+        this->cost = (costRoll % 2) + 5;
     } else {
         // Leisure locations have a cost of [3, 7]
-        this->cost = (rand() % 5) + 3;
+        this->cost = (costRoll % 5) + 3;
     }
 }
 
@@ -31,7 +36,10 @@ EconomicLocation::EconomicLocation(double x, double y, Agent::LOCATIONS type) :
 //******************************************************************************
 
 
-double EconomicLocation::getValue() {
+Currency EconomicLocation::getValue() {
+    if (ledger != nullptr) {
+        return ledger->getValue(ledgerIndex);
+    }
     return this->value;
 }
 
@@ -39,10 +47,17 @@ double EconomicLocation::getValue() {
 //******************************************************************************
 
 
-double EconomicLocation::incrementValue(double amount) {
-    double newValue = std::max(this->value + amount, 0.0);
+Currency EconomicLocation::incrementValue(Currency amount) {
+    if (ledger != nullptr) {
+        Currency newValue = ledger->incrementValue(ledgerIndex, amount);
+        updateValueBucket();
+        return newValue;
+    }
+
+    Currency newValue = std::max(this->value + amount, Currency());
     dailyValueChange += (newValue - this->value);
     this->value = newValue;
+    updateValueBucket();
     return this->value;
 }
 
@@ -52,6 +67,7 @@ double EconomicLocation::incrementValue(double amount) {
 
 void EconomicLocation::setSibling(EconomicLocation *other) {
     this->sibling = other;
+    markDirty();
 }
 
 
@@ -78,7 +94,11 @@ Agent::LOCATIONS EconomicLocation::getType() {
 
 
 bool EconomicLocation::makeHire() {
-    if (yesterdayValueChange > 2 * cost && !dailyHire) {
+    if (ledger != nullptr) {
+        return ledger->makeHire(ledgerIndex);
+    }
+
+    if (yesterdayValueChange > Currency::fromDouble(2 * cost) && !dailyHire) {
         dailyHire = true;
         return true;
     }
@@ -90,6 +110,9 @@ bool EconomicLocation::makeHire() {
 
 
 double EconomicLocation::getCost() {
+    if (ledger != nullptr) {
+        return ledger->getCost(ledgerIndex);
+    }
     return this->cost;
 }
 
@@ -97,7 +120,10 @@ double EconomicLocation::getCost() {
 //******************************************************************************
 
 
-double EconomicLocation::getYesterdayValueChange() {
+Currency EconomicLocation::getYesterdayValueChange() {
+    if (ledger != nullptr) {
+        return ledger->getYesterdayValueChange(ledgerIndex);
+    }
     return yesterdayValueChange;
 }
 
@@ -106,8 +132,13 @@ double EconomicLocation::getYesterdayValueChange() {
 
 
 void EconomicLocation::startNewDay() {
+    // Businesses in a ledger roll over together in BusinessLedger::startNewDay
+    if (ledger != nullptr) {
+        return;
+    }
+
     yesterdayValueChange = dailyValueChange;
-    dailyValueChange = 0;
+    dailyValueChange = Currency();
     this->dailyHire = false;
     this->totalDays++;
 }
@@ -117,8 +148,67 @@ void EconomicLocation::startNewDay() {
 
 
 int EconomicLocation::getDaysOpen() {
+    if (ledger != nullptr) {
+        return ledger->getDaysOpen(ledgerIndex);
+    }
     return this->totalDays;
 }
 
 
+//******************************************************************************
+
+
+void EconomicLocation::setValueHistogram(ValueHistogram* histogram) {
+    // Take the Location out of its previous histogram
+    if (valueHistogram != nullptr) {
+        valueHistogram->move(valueBucket, -1);
+    }
+    this->valueBucket = -1;
+    this->valueHistogram = histogram;
+    updateValueBucket();
+}
+
+
+//******************************************************************************
+
+
+int EconomicLocation::getValueBucket() {
+    // The ledger refreshes the bucket whenever it distributes value, so this
+    // is safe to read from the render thread
+    return this->valueBucket;
+}
+
+
+//******************************************************************************
+
+
+void EconomicLocation::setReceivingValue(bool receiving) {
+    if (ledger != nullptr) {
+        ledger->setShareholder(ledgerIndex, receiving);
+    }
+}
+
+
+//******************************************************************************
+
+
+void EconomicLocation::updateValueBucket() {
+    if (valueHistogram == nullptr) {
+        return;
+    }
+
+    // Only mark the location dirty when its value crosses a threshold. The
+    // sibling location shares this location's color, so mark it as well
+    int newBucket = valueHistogram->getBucket(getValue().toInt());
+    if (newBucket != valueBucket) {
+        valueHistogram->move(valueBucket, newBucket);
+        this->valueBucket = newBucket;
+        markDirty();
+        if (sibling != nullptr) {
+            sibling->markDirty();
+        }
+    }
+}
+
+
 //******************************************************************************
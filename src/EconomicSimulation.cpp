@@ -2,11 +2,13 @@
 
 EconomicSimulation::EconomicSimulation(int initialValue, int numAgents,
                                        Ui::MainWindow* ui,
-                                       std::map<std::string, bool> debug) :
-    SimpleSimulation(numAgents, ui, debug) {
+                                       std::map<std::string, bool> debug,
+                                       const SimulationSettings* settings) :
+    SimpleSimulation(numAgents, ui, debug, settings) {
 
     // Give the simulation some initial economic value
     this->totalEconomicValue = initialValue;
+    this->numFrames = 0;
 
     // Initialize the Chart Helpers
     agentValueHelper = new AgentValueChartHelper(initialValue);
@@ -24,19 +26,18 @@ EconomicSimulation::EconomicSimulation(int initialValue, int numAgents,
 
 void EconomicSimulation::execute() {
 
-    // Static counter to determine if an hour has passed
-    static int numFrames = 0;
-
     // Run the Simple Simulation's execute function
     SimpleSimulation::execute();
 
     // Update the overall values
     EconomicController* econController = dynamic_cast<EconomicController*>(getController());
-    this->businessEconomicValue = econController->getTotalBusinessValue();
-    this->totalEconomicValue = businessEconomicValue + econController->getTotalAgentValue();
+    this->businessEconomicValue = econController->getTotalBusinessValue().toInt();
+    this->totalEconomicValue = businessEconomicValue + econController->getTotalAgentValue().toInt();
 
     // Update the current value displayed on the screen
-    getUI()->currentValue->setText(QString::number(totalEconomicValue));
+    if (getUI() != nullptr) {
+        getUI()->currentValue->setText(QString::number(totalEconomicValue));
+    }
 
     // Every hour update the Economic Charts
     if (numFrames == FRAMES_PER_HOUR) {
@@ -62,6 +63,12 @@ void EconomicSimulation::init(std::string type) {
 
     // Distribute a portion economic value equally to Work Locations
     double businessValue = totalEconomicValue / 2;
+    EconomicController* controller = dynamic_cast<EconomicController*>(getController());
+
+    // Index the homes by cost so homeless agents can find one they can afford
+    if (controller != nullptr) {
+        controller->indexHomes(getRegion(Agent::HOME)->getLocations());
+    }
 
     for (size_t i = 0; i < workLocations.size(); ++i) {
         // Cast the base Location pointers to EconomicLocation pointers
@@ -72,8 +79,16 @@ void EconomicSimulation::init(std::string type) {
         workLocation->setSibling(leisureLocation);
         leisureLocation->setSibling(workLocation);
 
+        // Keep the business's economic state in the controller's ledger
+        if (controller != nullptr) {
+            controller->openBusiness(workLocation);
+        }
+
+        // Count the business in the value histogram for charts and coloring
+        workLocation->setValueHistogram(&workValueHelper->getHistogram());
+
         // Give the business a certain portion of the Sim's total Economic Value
-        workLocation->incrementValue(businessValue / workLocations.size());
+        workLocation->incrementValue(Currency::fromDouble(businessValue / workLocations.size()));
     }
 
     // Initialize the total value for businesses
@@ -104,6 +119,13 @@ void EconomicSimulation::generateAgents(int num, bool birth, std::string type) {
     QMutexLocker lock(getAgentsLock());
     std::vector<Agent*> agents = getAgents();
 
+    // Count each new agent in the value histogram for charts and coloring
+    size_t numNew = std::min(agents.size(), static_cast<size_t>(num));
+    for (size_t i = agents.size() - numNew; i < agents.size(); ++i) {
+        EconomicAgent* agent = dynamic_cast<EconomicAgent*>(agents[i]);
+        agent->setValueHistogram(&agentValueHelper->getHistogram());
+    }
+
     // Distribute economic value to agents based on their age
     if (!birth) {
 
@@ -184,19 +206,22 @@ void EconomicSimulation::renderChartUpdates(QString which, bool newChartView) {
         return;
     }
 
+    // Read the counts from the most recent statistics rather than the Agents
+    SimulationStats stats = getStats();
+
     if (which == "AGENT VALUE") {
         if (newChartView) {
-            QtCharts::QChart* chart = agentValueHelper->getChart(&getAgents());
+            QtCharts::QChart* chart = agentValueHelper->getChart(stats);
             addChartToView(chart, graphView);
         } else {
-            agentValueHelper->updateChart(&getAgents());
+            agentValueHelper->updateChart(stats);
         }
     } else if (which == "BUSINESS VALUE") {
         if (newChartView) {
-            QtCharts::QChart* chart = workValueHelper->getChart(&getRegion(Agent::WORK)->getLocations());
+            QtCharts::QChart* chart = workValueHelper->getChart(stats);
             addChartToView(chart, graphView);
         } else {
-            workValueHelper->updateChart(&getRegion(Agent::WORK)->getLocations());
+            workValueHelper->updateChart(stats);
         }
     } else if (which == "TOTAL VALUE") {
         if (newChartView) {
@@ -207,14 +232,14 @@ void EconomicSimulation::renderChartUpdates(QString which, bool newChartView) {
         }
     } else if (which == "ECONOMIC STATUS") {
         if (newChartView) {
-            QtCharts::QChart* chart = statusHelper->getChart(getNumHomelessAgents(),
-                                                             getNumUnemployedAgents(),
-                                                             static_cast<int>(getAgents().size()));
+            QtCharts::QChart* chart = statusHelper->getChart(stats.numHomeless,
+                                                             stats.numUnemployed,
+                                                             stats.numAgents);
             addChartToView(chart, graphView);
         } else {
-            statusHelper->updateChart(getNumHomelessAgents(),
-                                      getNumUnemployedAgents(),
-                                      static_cast<int>(getAgents().size()));
+            statusHelper->updateChart(stats.numHomeless,
+                                      stats.numUnemployed,
+                                      stats.numAgents);
         }
     } else {
         SimpleSimulation::renderChartUpdates(which, newChartView);
@@ -236,8 +261,44 @@ void EconomicSimulation::updateEconomicCharts() {
 //******************************************************************************
 
 
-std::vector<int>& EconomicSimulation::getBusinessThresholds() {
-    return workValueHelper->getThresholds();
+void EconomicSimulation::collectAgentStats(Agent* agent, SimulationStats &stats) {
+    SimpleSimulation::collectAgentStats(agent, stats);
+
+    // Only Economic Agents hold value
+    EconomicAgent* economicAgent = dynamic_cast<EconomicAgent*>(agent);
+    if (economicAgent == nullptr) {
+        return;
+    }
+
+    // Count whether the Agent is homeless or unemployed
+    EconomicAgent::STATUS status = economicAgent->getStatus();
+    if (status == EconomicAgent::HOMELESS || status == EconomicAgent::BOTH) {
+        stats.numHomeless++;
+    }
+    if (status == EconomicAgent::UNEMPLOYED || status == EconomicAgent::BOTH) {
+        stats.numUnemployed++;
+    }
+}
+
+
+//******************************************************************************
+
+
+void EconomicSimulation::collectLocationStats(SimulationStats &stats) {
+    SimpleSimulation::collectLocationStats(stats);
+
+    // Agents and businesses keep their value histograms up to date as their
+    // values change, so only the counts need to be copied
+    stats.agentValueCounts = agentValueHelper->getHistogram().getCounts();
+    stats.businessValueCounts = workValueHelper->getHistogram().getCounts();
+}
+
+
+//******************************************************************************
+
+
+ValueHistogram& EconomicSimulation::getBusinessHistogram() {
+    return workValueHelper->getHistogram();
 }
 
 
@@ -349,9 +410,11 @@ double EconomicSimulation::getTotalEconomicValue() {
 EconomicSimulation::~EconomicSimulation() {
 
     // Remove any memory traces from the chartViews
-    getUI()->graphView1->setChart(new QtCharts::QChart());
-    getUI()->graphView2->setChart(new QtCharts::QChart());
-    getUI()->graphView3->setChart(new QtCharts::QChart());
+    if (getUI() != nullptr) {
+        getUI()->graphView1->setChart(new QtCharts::QChart());
+        getUI()->graphView2->setChart(new QtCharts::QChart());
+        getUI()->graphView3->setChart(new QtCharts::QChart());
+    }
 
     // Delete the chart helpers
     delete agentValueHelper;
@@ -374,63 +437,58 @@ void EconomicSimulation::renderAgentUpdate() {
         return;
     }
 
-    const static std::vector<int> businessThresholds = workValueHelper->getThresholds();
-    const static std::vector<int> agentThresholds = agentValueHelper->getThresholds();
-
-    // Update the colors of the Locations based on their current value
-    std::vector<Location*> workLocations = getRegion(Agent::WORK)->getLocations();
-    for (size_t i = 0; i < workLocations.size(); ++i) {
+    // Update the colors of the Locations whose value crossed a threshold
+    std::vector<Location*> locations = takeDirtyLocations();
+    for (size_t i = 0; i < locations.size(); ++i) {
         // Cast the pointer to an Economic Location*
-        EconomicLocation* workLocation = dynamic_cast<EconomicLocation*>(workLocations[i]);
-        int locationValue = workLocation->getValue();
-
-        // Determine the appriopriate color from the value
-        QColor color;
-        if (locationValue == businessThresholds[0]) {
-            color = QColor(255, 0, 0);
-        } else if (locationValue < businessThresholds[1]) {
-            color = QColor(235, 143, 52);
-        } else if (locationValue < businessThresholds[2]) {
-            color = QColor(235, 220, 52);
-        } else if (locationValue < businessThresholds[3]) {
-            color = QColor(186, 235, 52);
-        } else {
-            color = QColor(27, 163, 3);
+        EconomicLocation* location = dynamic_cast<EconomicLocation*>(locations[i]);
+        if (location == nullptr) {
+            continue;
         }
 
-        // Assign the color to both the Work and Leisure location
-        workLocation->setColor(color);
-        workLocation->getSibling()->setColor(color);
+        // Leisure locations share the color of their sibling Work location
+        EconomicLocation* business = nullptr;
+        if (location->getType() == Agent::WORK) {
+            business = location;
+        } else if (location->getType() == Agent::LEISURE) {
+            business = location->getSibling();
+        }
+
+        if (business != nullptr && business->getValueBucket() != -1) {
+            location->setColor(getValueColor(business->getValueBucket()));
+        }
     }
 
     // Unlock the Locations lock
     locationLock.unlock();
 
-    // Update the colors of the Agents based on their current value
+    // Update the colors of the Agents whose value crossed a threshold
     QMutexLocker lock(getAgentsLock());
-    std::vector<Agent*> agents = getAgents();
+    std::vector<Agent*> agents = takeDirtyAgents();
     for (size_t i = 0; i < agents.size(); ++i) {
         // Cast the agent to an Economic Agent
         EconomicAgent* agent = dynamic_cast<EconomicAgent*>(agents[i]);
-        int agentValue = agent->getValue();
-
-        // Determine the appriopriate color from the value
-        QColor color;
-        if (agentValue == agentThresholds[0]) {
-            color = QColor(255, 0, 0);
-        } else if (agentValue < agentThresholds[1]) {
-            color = QColor(235, 143, 52);
-        } else if (agentValue < agentThresholds[2]) {
-            color = QColor(235, 220, 52);
-        } else if (agentValue < agentThresholds[3]) {
-            color = QColor(186, 235, 52);
-        } else {
-            color = QColor(27, 163, 3);
+        if (agent != nullptr && agent->getValueBucket() != -1) {
+            agent->setColor(getValueColor(agent->getValueBucket()));
         }
+    }
+}
+
+
+//******************************************************************************
+
 
-        // Update the agents color
-        agent->setColor(color);
+QColor EconomicSimulation::getValueColor(int bucket) {
+    if (bucket == 0) {
+        return QColor(255, 0, 0);
+    } else if (bucket == 1) {
+        return QColor(235, 143, 52);
+    } else if (bucket == 2) {
+        return QColor(235, 220, 52);
+    } else if (bucket == 3) {
+        return QColor(186, 235, 52);
     }
+    return QColor(27, 163, 3);
 }
 
 
@@ -439,7 +497,7 @@ void EconomicSimulation::renderAgentUpdate() {
 
 void EconomicSimulation::renderCharts(const QString &which, bool newChartView) {
 
-    if (getUI()->headlessMode->checkState() == Qt::CheckState::Checked) {
+    if (isHeadless()) {
         return;
     }
 
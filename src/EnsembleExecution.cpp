@@ -0,0 +1,253 @@
+#include "Headers/EnsembleExecution.h"
+#include "Headers/PandemicSimulation.h"
+#include "Headers/DualSimulation.h"
+#include "Headers/mainwindow.h"
+
+#include "QDir"
+#include "QFile"
+#include "QTextStream"
+
+EnsembleRunner::EnsembleRunner(Ui::MainWindow* ui, QString type, int numReplicates,
+                               int numDays, unsigned int seed) {
+
+    // Initialize the settings for the ensemble. The replicates never touch
+    // the UI, so read everything they need from it now
+    this->settings = MainWindow::readSettings(ui);
+    this->debug = MainWindow::checkDebugInfo(ui);
+    this->numAgents = ui->numAgents->value();
+    this->lagPeriod = ui->lagPeriod->value();
+    this->initialInfected = ui->initialInfected->value();
+    this->initialValue = ui->initialValueSlider->value();
+    this->type = type;
+    this->numReplicates = std::max(1, numReplicates);
+    this->numHours = std::max(1, numDays) * 24;
+    this->seed = seed;
+
+    // Summarize the results once every replicate has finished
+    connect(&watcher, &QFutureWatcher<void>::finished, this, &EnsembleRunner::finishEnsemble);
+}
+
+
+//******************************************************************************
+
+
+void EnsembleRunner::startEnsemble() {
+
+    // Create every replicate
+    replicates = std::vector<Replicate>(numReplicates);
+    for (int i = 0; i < numReplicates; ++i) {
+        replicates[i].index = i;
+        replicates[i].seed = seed + static_cast<unsigned int>(i);
+        createReplicate(replicates[i]);
+    }
+
+    // Every replicate writes its samples to its own slots
+    samples = std::vector<double>(static_cast<size_t>(METRICS_MAX) * numHours * numReplicates, 0);
+
+    emit printMessage(QString("Running an ensemble of %1 %2 simulations with seed %3")
+                      .arg(numReplicates).arg(type).arg(seed));
+
+    // Run the replicates across the global thread pool
+    watcher.setFuture(QtConcurrent::map(replicates, [this](Replicate &replicate) {
+        runReplicate(replicate);
+    }));
+}
+
+
+//******************************************************************************
+
+
+void EnsembleRunner::createReplicate(Replicate &replicate) {
+
+    // Create the replicate without a UI, so it reads the ensemble's settings
+    // and never draws anything
+    if (type == "Dual") {
+        replicate.sim = new DualSimulation(lagPeriod, initialInfected, initialValue,
+                                           numAgents, nullptr, debug, nullptr, &settings);
+    } else {
+        replicate.sim = new PandemicSimulation(lagPeriod, initialInfected, 0,
+                                               numAgents, nullptr, debug, &settings);
+    }
+    // Seed the replicate's own engine before any of its Agents and Locations
+    // are created
+    replicate.sim->seedRandom(replicate.seed);
+    replicate.sim->init(type.toStdString());
+    replicate.sim->mapChartViews();
+}
+
+
+//******************************************************************************
+
+
+void EnsembleRunner::runReplicate(Replicate &replicate) {
+
+    // Run the replicate one hour at a time, recording a sample after each hour
+    for (int hour = 0; hour < numHours; ++hour) {
+        for (int frame = 0; frame < Simulation::FRAMES_PER_HOUR; ++frame) {
+            replicate.sim->execute();
+
+            // A fast-forwarded frame runs the whole hour by itself
+            if (replicate.sim->wasFastForwarded()) {
+                break;
+            }
+        }
+        recordSample(replicate, hour);
+    }
+}
+
+
+//******************************************************************************
+
+
+void EnsembleRunner::recordSample(Replicate &replicate, int hour) {
+    std::vector<int> SEIR = replicate.sim->getNumSEIR();
+    double values[METRICS_MAX] = {
+        static_cast<double>(SEIR[PandemicAgent::SUSCEPTIBLE]),
+        static_cast<double>(SEIR[PandemicAgent::EXPOSED]),
+        static_cast<double>(SEIR[PandemicAgent::INFECTED]),
+        static_cast<double>(SEIR[PandemicAgent::RECOVERED]),
+        static_cast<double>(replicate.sim->getTotalCases()),
+        static_cast<double>(replicate.sim->getTotalDeaths()),
+        replicate.sim->getTotalEconomicValue()
+    };
+
+    for (int metric = 0; metric < METRICS_MAX; ++metric) {
+        size_t slot = (static_cast<size_t>(metric) * numHours + hour) * numReplicates + replicate.index;
+        samples[slot] = values[metric];
+    }
+}
+
+
+//******************************************************************************
+
+
+void EnsembleRunner::summarize() {
+    bands = std::vector<EnsembleBand>(METRICS_MAX);
+    std::vector<double> values(numReplicates);
+
+    for (int metric = 0; metric < METRICS_MAX; ++metric) {
+        EnsembleBand &band = bands[metric];
+        band.low = std::vector<double>(numHours);
+        band.median = std::vector<double>(numHours);
+        band.high = std::vector<double>(numHours);
+
+        // Sort the samples of every replicate for the hour and take the quantiles
+        for (int hour = 0; hour < numHours; ++hour) {
+            size_t first = (static_cast<size_t>(metric) * numHours + hour) * numReplicates;
+            std::copy(samples.begin() + first, samples.begin() + first + numReplicates, values.begin());
+            std::sort(values.begin(), values.end());
+
+            band.low[hour] = getQuantile(values, LOW_QUANTILE);
+            band.median[hour] = getQuantile(values, 0.5);
+            band.high[hour] = getQuantile(values, HIGH_QUANTILE);
+        }
+    }
+}
+
+
+//******************************************************************************
+
+
+bool EnsembleRunner::writeSummary(const QString &filename) {
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    // Write a low, median, and high column for every metric
+    const char* names[METRICS_MAX] = {"susceptible", "exposed", "infected", "recovered",
+                                      "total_cases", "total_deaths", "total_value"};
+    QTextStream out(&file);
+    out << "hour";
+    for (int metric = 0; metric < METRICS_MAX; ++metric) {
+        out << "," << names[metric] << "_p5"
+            << "," << names[metric] << "_p50"
+            << "," << names[metric] << "_p95";
+    }
+    out << "\n";
+
+    for (int hour = 0; hour < numHours; ++hour) {
+        out << hour + 1;
+        for (int metric = 0; metric < METRICS_MAX; ++metric) {
+            out << "," << bands[metric].low[hour]
+                << "," << bands[metric].median[hour]
+                << "," << bands[metric].high[hour];
+        }
+        out << "\n";
+    }
+    return true;
+}
+
+
+//******************************************************************************
+
+
+void EnsembleRunner::finishEnsemble() {
+    summarize();
+
+    // Save the summary next to the application
+    QString dirname = QString("%1/ensemble").arg(QDir::currentPath());
+    QString filename = QString("%1/%2_%3.csv").arg(dirname).arg(type.toLower()).arg(seed);
+    QDir().mkpath(dirname);
+    if (writeSummary(filename)) {
+        emit printMessage(QString("Ensemble summary written to %1").arg(filename));
+    } else {
+        emit printMessage(QString("Unable to write ensemble summary to %1").arg(filename));
+        filename = QString();
+    }
+
+    // Report the final totals
+    int last = numHours - 1;
+    emit printMessage(QString("Total cases: %1 (%2 - %3)")
+                      .arg(bands[TOTAL_CASES].median[last])
+                      .arg(bands[TOTAL_CASES].low[last])
+                      .arg(bands[TOTAL_CASES].high[last]));
+    emit printMessage(QString("Total deaths: %1 (%2 - %3)")
+                      .arg(bands[TOTAL_DEATHS].median[last])
+                      .arg(bands[TOTAL_DEATHS].low[last])
+                      .arg(bands[TOTAL_DEATHS].high[last]));
+
+    // Free the replicates
+    for (size_t i = 0; i < replicates.size(); ++i) {
+        delete replicates[i].sim;
+    }
+    replicates.clear();
+
+    emit ensembleFinished(filename);
+}
+
+
+//******************************************************************************
+
+
+const std::vector<EnsembleBand>& EnsembleRunner::getBands() {
+    return bands;
+}
+
+
+//******************************************************************************
+
+
+double EnsembleRunner::getQuantile(const std::vector<double> &sorted, double quantile) {
+    if (sorted.empty()) {
+        return 0;
+    }
+
+    // Interpolate between the two samples on either side of the quantile
+    double position = quantile * (sorted.size() - 1);
+    size_t lower = static_cast<size_t>(position);
+    size_t upper = std::min(lower + 1, sorted.size() - 1);
+    double fraction = position - lower;
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+}
+
+
+//******************************************************************************
+
+
+EnsembleRunner::~EnsembleRunner() {
+    watcher.waitForFinished();
+    for (size_t i = 0; i < replicates.size(); ++i) {
+        delete replicates[i].sim;
+    }
+}
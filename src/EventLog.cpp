@@ -0,0 +1,195 @@
+#include "Headers/EventLog.h"
+
+#include <atomic>
+
+// The file format depends on every record being exactly this size
+static_assert(sizeof(EventLog::Record) == 24, "EventLog::Record must be 24 bytes");
+
+namespace {
+
+// The buffer the calling thread last recorded into, and the log it belongs to.
+// Only trusted while the log's ID matches, since IDs are never reused
+struct LocalBuffer {
+    quint64 log;
+    std::vector<EventLog::Record>* buffer;
+};
+thread_local LocalBuffer localBuffer = {0, nullptr};
+
+}
+
+EventLog::EventLog(const QString &filename) : file(filename) {
+    static std::atomic<quint64> instanceCounter(0);
+    instance = ++instanceCounter;
+
+    // Buffers must be written in the order they are submitted
+    writer.setMaxThreadCount(1);
+
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        quint32 header[3] = {MAGIC, VERSION, static_cast<quint32>(sizeof(Record))};
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    }
+}
+
+
+//******************************************************************************
+
+
+bool EventLog::isOpen() {
+    return file.isOpen();
+}
+
+
+//******************************************************************************
+
+
+QString EventLog::getFilename() {
+    return file.fileName();
+}
+
+
+//******************************************************************************
+
+
+void EventLog::record(TYPE type, int hour, int agentID, int locationID, long long amount) {
+    std::vector<Record> &buffer = getBuffer();
+    Record event;
+    event.hour = static_cast<quint32>(hour);
+    event.type = static_cast<quint16>(type);
+    event.flags = 0;
+    event.agentID = agentID;
+    event.locationID = locationID;
+    event.amount = amount;
+    buffer.push_back(event);
+
+    if (buffer.size() >= BUFFER_RECORDS) {
+        submit(buffer);
+    }
+}
+
+
+//******************************************************************************
+
+
+void EventLog::flush() {
+    {
+        QMutexLocker lock(&buffersLock);
+        for (auto it = buffers.begin(); it != buffers.end(); ++it) {
+            if (!it->second->empty()) {
+                submit(*it->second);
+            }
+        }
+    }
+    writer.waitForDone();
+
+    if (file.isOpen()) {
+        file.flush();
+    }
+}
+
+
+//******************************************************************************
+
+
+QString EventLog::getTypeName(int type) {
+    switch (type) {
+    case HIRE:
+        return "hire";
+    case UNEMPLOYED:
+        return "unemployed";
+    case HOMELESS:
+        return "homeless";
+    case BANKRUPTCY:
+        return "bankruptcy";
+    case NEW_BUSINESS:
+        return "new_business";
+    case EXPOSED:
+        return "exposed";
+    case INFECTED:
+        return "infected";
+    case DEATH:
+        return "death";
+    default:
+        return "unknown";
+    }
+}
+
+
+//******************************************************************************
+
+
+bool EventLog::readLog(const QString &filename, std::vector<Record> &records) {
+    QFile input(filename);
+    if (!input.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    // Reject files that were not written by this version of the EventLog
+    quint32 header[3];
+    if (input.read(reinterpret_cast<char*>(header), sizeof(header)) != static_cast<qint64>(sizeof(header)) ||
+            header[0] != MAGIC || header[1] != VERSION || header[2] != sizeof(Record)) {
+        return false;
+    }
+
+    // A trailing partial record means the writer was interrupted, so drop it
+    qint64 numRecords = (input.size() - static_cast<qint64>(sizeof(header))) / static_cast<qint64>(sizeof(Record));
+    size_t start = records.size();
+    records.resize(start + static_cast<size_t>(numRecords));
+    qint64 bytes = numRecords * static_cast<qint64>(sizeof(Record));
+    return input.read(reinterpret_cast<char*>(records.data() + start), bytes) == bytes;
+}
+
+
+//******************************************************************************
+
+
+EventLog::~EventLog() {
+    flush();
+    file.close();
+}
+
+
+//******************************************************************************
+
+
+std::vector<EventLog::Record>& EventLog::getBuffer() {
+    if (localBuffer.log == instance) {
+        return *localBuffer.buffer;
+    }
+
+    // The thread hasn't recorded into this log yet, or has recorded into
+    // another log since, so look its buffer up and cache it
+    QMutexLocker lock(&buffersLock);
+    std::unique_ptr<std::vector<Record>> &buffer = buffers[QThread::currentThread()];
+    if (!buffer) {
+        buffer.reset(new std::vector<Record>());
+        buffer->reserve(BUFFER_RECORDS);
+    }
+    localBuffer.log = instance;
+    localBuffer.buffer = buffer.get();
+    return *buffer;
+}
+
+
+//******************************************************************************
+
+
+void EventLog::submit(std::vector<Record> &buffer) {
+    std::shared_ptr<std::vector<Record>> full(new std::vector<Record>());
+    full->swap(buffer);
+    buffer.reserve(BUFFER_RECORDS);
+    QtConcurrent::run(&writer, [this, full]() { write(full); });
+}
+
+
+//******************************************************************************
+
+
+void EventLog::write(std::shared_ptr<std::vector<Record>> records) {
+    if (file.isOpen()) {
+        file.write(reinterpret_cast<const char*>(records->data()),
+                   static_cast<qint64>(records->size() * sizeof(Record)));
+    }
+}
+
+
+//******************************************************************************
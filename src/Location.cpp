@@ -1,4 +1,5 @@
 #include <Headers/Location.h>
+#include "Headers/Simulation.h"
 
 Location::Location(double x, double y, bool temporary) {
     position = Coordinate(x, y);
@@ -24,8 +25,11 @@ Location::Location(double x, double y, bool temporary) {
     agents = std::unordered_set<Agent*>();
 
     // Initialize the Location's ID
-    static int id_counter = 0;
+    static std::atomic<int> id_counter(0);
     this->id = id_counter++;
+
+    // The location does not belong to a Simulation until it is added to one
+    this->sim = nullptr;
 }
 
 
@@ -34,6 +38,7 @@ Location::Location(double x, double y, bool temporary) {
 
 void Location::addAgent(Agent *agent) {
     agents.insert(agent);
+    markChanged();
 }
 
 
@@ -43,6 +48,7 @@ void Location::addAgent(Agent *agent) {
 void Location::removeAgent(Agent* agent) {
     if(agents.find(agent) != agents.end()) {
         agents.erase(agent);
+        markChanged();
     }
 }
 
@@ -84,6 +90,14 @@ std::unordered_set<Agent*> Location::getAgents() {
 //******************************************************************************
 
 
+const std::unordered_set<Agent*>& Location::getAgentSet() {
+    return this->agents;
+}
+
+
+//******************************************************************************
+
+
 int Location::getID() {
     return this->id;
 }
@@ -119,3 +133,31 @@ bool Location_Comparator::operator()(Location *test) {
 int Location::getNumAgents() {
     return static_cast<int>(agents.size());
 }
+
+
+//******************************************************************************
+
+
+void Location::setSimulation(Simulation* sim) {
+    this->sim = sim;
+}
+
+
+//******************************************************************************
+
+
+void Location::markDirty() {
+    if (sim != nullptr) {
+        sim->markDirty(this);
+    }
+}
+
+
+//******************************************************************************
+
+
+void Location::markChanged() {
+    if (sim != nullptr) {
+        sim->getController()->locationChanged(this);
+    }
+}
@@ -1,4 +1,5 @@
 #include "Headers/PandemicAgent.h"
+#include "Headers/Simulation.h"
 
 PandemicAgent::PandemicAgent(int age, Location* startingLocation,
                              QString startingLocationString, int behavior) :
@@ -7,20 +8,11 @@ PandemicAgent::PandemicAgent(int age, Location* startingLocation,
     // Give the agent the default pandemic status
     this->currentStatus = SUSCEPTIBLE;
     this->daysInStage = 0;
+    this->transitionDay = -1;
+    this->exposedLocations = 0;
     this->compliant = true;
     this->nearbyInfected = 0;
-
-    // Give the agent a random health status, proportional to the US population
-    int randNum = rand() % 100;
-    if (randNum < 50) {
-        this->healthStatus = HEALTHY;
-    } else if (randNum < 75) {
-        this->healthStatus = MODERATE;
-    } else if (randNum < 90) {
-        this->healthStatus = POOR;
-    } else {
-        this->healthStatus = VERY_POOR;
-    }
+    this->healthStatus = HEALTHY;
 }
 
 
@@ -43,33 +35,49 @@ PandemicAgent::HEALTH PandemicAgent::getHealthStatus() {
 //******************************************************************************
 
 
+void PandemicAgent::rollHealthStatus(int roll) {
+    int randNum = roll % 100;
+    if (randNum < 50) {
+        this->healthStatus = HEALTHY;
+    } else if (randNum < 75) {
+        this->healthStatus = MODERATE;
+    } else if (randNum < 90) {
+        this->healthStatus = POOR;
+    } else {
+        this->healthStatus = VERY_POOR;
+    }
+}
+
+
+//******************************************************************************
+
+
 void PandemicAgent::setStatus(STATUS newStatus) {
-    this->currentStatus = newStatus;
+    if (newStatus != currentStatus) {
+        this->currentStatus = newStatus;
+        markDirty();
+    }
 }
 
 
 //******************************************************************************
 
 
-bool PandemicAgent::advanceDay() {
+bool PandemicAgent::advanceStage() {
 
     bool newCase = false;
     if (currentStatus == EXPOSED) {
-        if (daysInStage + ((rand() % 3) - 1) > 1) {
-            makeInfected();
-            newCase = true;
-        }
+        makeInfected();
+        newCase = true;
     } else if (currentStatus == INFECTED) {
-        if (daysInStage + ((rand() % 3) - 1) > 4) {
-            makeRecovered();
-        }
+        makeRecovered();
     } else if (currentStatus == RECOVERED) {
-        if (daysInStage + ((rand() % 3) - 1) > 21) {
-            makeSusceptible();
-        }
+        makeSusceptible();
     }
 
-    ++this->daysInStage;
+    // The transition happens during a daily check, so the next check already
+    // counts one day in the new stage
+    this->daysInStage = 1;
     return newCase;
 }
 
@@ -77,6 +85,81 @@ bool PandemicAgent::advanceDay() {
 //******************************************************************************
 
 
+int PandemicAgent::sampleStageLength() {
+
+    // Determine the threshold for leaving the current stage
+    int threshold;
+    if (currentStatus == EXPOSED) {
+        threshold = 1;
+    } else if (currentStatus == INFECTED) {
+        threshold = 4;
+    } else if (currentStatus == RECOVERED) {
+        threshold = 21;
+    } else {
+        return -1;
+    }
+
+    // Roll the jitter for each daily check until the threshold is passed
+    int day = daysInStage;
+    while (day + ((sim->getRandom() % 3) - 1) <= threshold) {
+        ++day;
+    }
+    return day - daysInStage + 1;
+}
+
+
+//******************************************************************************
+
+
+int PandemicAgent::getTransitionDay() {
+    return this->transitionDay;
+}
+
+
+//******************************************************************************
+
+
+void PandemicAgent::setTransitionDay(int day) {
+    this->transitionDay = day;
+}
+
+
+//******************************************************************************
+
+
+void PandemicAgent::setLocation(Location* location, LOCATIONS which) {
+    Agent::setLocation(location, which);
+
+    // The new location may or may not have Infected Agents
+    PandemicLocation* pandemicLocation = dynamic_cast<PandemicLocation*>(location);
+    setLocationExposure(which, pandemicLocation != nullptr &&
+                               pandemicLocation->getNumInfectedAgents() > 0);
+}
+
+
+//******************************************************************************
+
+
+void PandemicAgent::setLocationExposure(LOCATIONS which, bool exposed) {
+    if (exposed) {
+        exposedLocations |= (1u << static_cast<int>(which));
+    } else {
+        exposedLocations &= ~(1u << static_cast<int>(which));
+    }
+}
+
+
+//******************************************************************************
+
+
+bool PandemicAgent::hasExposedLocation() {
+    return exposedLocations != 0;
+}
+
+
+//******************************************************************************
+
+
 void PandemicAgent::makeSusceptible() {
     setStatus(SUSCEPTIBLE);
     this->daysInStage = 0;
@@ -89,6 +172,7 @@ void PandemicAgent::makeSusceptible() {
 void PandemicAgent::makeExposed() {
     setStatus(EXPOSED);
     daysInStage = 0;
+    logEvent(EventLog::EXPOSED);
 }
 
 
@@ -98,6 +182,7 @@ void PandemicAgent::makeExposed() {
 void PandemicAgent::makeInfected() {
     setStatus(INFECTED);
     this->daysInStage = 0;
+    logEvent(EventLog::INFECTED);
 
     // Update the number of Infected agents at each location
     PandemicLocation* location = dynamic_cast<PandemicLocation*>(getLocation(Agent::HOME));
@@ -155,19 +240,17 @@ void PandemicAgent::makeRecovered() {
 //******************************************************************************
 
 
-bool PandemicAgent::evaluateDeathProbability(int numInfected, int hospitalCapacity) {
+int PandemicAgent::getDeathOdds(int age, HEALTH healthStatus, int overflow) {
 
     double survivalProbability;
-    if (getAge() < 50) {
+    if (age < 50) {
         survivalProbability = 100;
     } else {
-        survivalProbability = 100 - 2 * (getAge() - 50);
+        survivalProbability = 100 - 2 * (age - 50);
     }
 
     // Decrease the probability of surviving if the number of infected agents is too high
-    if (numInfected > hospitalCapacity) {
-        survivalProbability = survivalProbability - 10 * (numInfected / hospitalCapacity);
-    }
+    survivalProbability = survivalProbability - 10 * overflow;
 
     if (healthStatus == MODERATE) {
         survivalProbability = survivalProbability / 2;
@@ -178,11 +261,7 @@ bool PandemicAgent::evaluateDeathProbability(int numInfected, int hospitalCapaci
     }
 
     survivalProbability = std::max(survivalProbability, 1.0);
-
-    if (rand() % static_cast<int>((survivalProbability * 100)) == 0) {
-        return true;
-    }
-    return false;
+    return static_cast<int>(survivalProbability * 100);
 }
 
 
@@ -243,7 +322,8 @@ void PandemicAgent::incrementNearbyInfected(int amount) {
 //******************************************************************************
 
 
-bool PandemicAgent::evaluateInfectionProbability(bool checkCompliance, bool guidelines) {
+bool PandemicAgent::evaluateInfectionProbability(bool checkCompliance, bool guidelines,
+                                                 int infectionRoll, int guidelineRoll) {
     // Only Susceptible agents can become exposed
     if (getStatus() != PandemicAgent::SUSCEPTIBLE) return false;
 
@@ -253,9 +333,9 @@ bool PandemicAgent::evaluateInfectionProbability(bool checkCompliance, bool guid
         threshold = 3500;
     }
 
-    if (rand() % threshold < infectionLiklihood) {
+    if (infectionRoll % threshold < infectionLiklihood) {
         // If strong enough guidelines and compliance, give an agent a 1/4 chance to avoid infection
-        if (guidelines && compliant && rand() % 4 == 0) {
+        if (guidelines && compliant && guidelineRoll % 4 == 0) {
             return false;
         }
         makeExposed();
@@ -18,14 +18,31 @@ PandemicController::PandemicController(Simulation* sim) :
     numRecovered = 0;
 
     initialInfection = false;
+    lockdownPolicy = LOCKDOWN_UNKNOWN;
     last24Exposed = std::deque<int>(24, 0);
     last24Deaths = std::deque<int>(24, 0);
 
+    // The mortality table is built on the first update
+    mortalityOverflow = -1;
+
+    // Start with an empty transition calendar
+    transitionCalendar = std::vector<std::vector<PandemicAgent*>>(CALENDAR_DAYS);
+    currentDay = 0;
+
     // Check if Agent Compliance will have any effect on infection spread
     checkCompliance = (sim->checkDebug("weak non-compliance") ||
                        sim->checkDebug("moderate non-compliance") ||
                        sim->checkDebug("strong non-compliance"));
 
+    // Read the interventions that are in effect to begin
+    readInterventionPolicy();
+
+    // Select how the virus is transmitted for this run
+    if (sim->checkDebug("location contact transmission")) {
+        transmission = LOCATION_CONTACT;
+    } else {
+        transmission = RADIUS;
+    }
 }
 
 
@@ -37,19 +54,15 @@ void PandemicController::updateAgentDestinations(std::vector<Agent *> &agents, i
     // Initialize the needed fields for the Pandemic Update
     initializePandemicUpdate(agents);
 
-    // Loop through every agent
+    // Update each Agent's destination if necessary
     for (int i = static_cast<int>(pandemicAgents.size()) - 1; i >= 0; --i) {
-
-        // Update the Agent's destination if necessary
         updateSingleDestination(pandemicAgents[i], hour, true);
-
-        // Update the Pandemic status of the Agent
-        bool died = agentPandemicUpdate(pandemicAgents[i], static_cast<int>(i));
-        if (died) {
-            pandemicAgents[i] = nullptr;
-        }
     }
 
+    // Give every Infected Agent a chance to die and remove the dead at once
+    std::vector<int> deaths = evaluateMortality(pandemicAgents);
+    applyMortality(pandemicAgents, deaths);
+
     // Give the infection a chance to reappear in the population
     spontaneousInfection();
 
@@ -74,53 +87,119 @@ void PandemicController::updateSingleDestination(Agent* agent, int hour, bool) {
     }
 
     // If a total lockdown is in effect, immediately send all agents home
-    if (sim->checkDebug("total lockdown")) {
+    if (policy.totalLockdown) {
         agent->setDestination(*home, "Home");
         return;
     }
 
+    // Run the kernel selected for the interventions in effect this hour
+    (this->*destinationKernel)(castAgent, home, hour);
+}
+
+
+//******************************************************************************
+
+
+template <bool ECOMMERCE, bool QUARANTINE, bool CONTACT_TRACING, bool GUIDELINES>
+void PandemicController::updateDestination(PandemicAgent* agent, Location* home, int hour) {
+
     // If the Agent has been assigned to a new location, enforce the Pandemic
     // rules
     QString destinationString = getAgentDestination(agent, hour);
-    if (destinationString != "No Change") {
+    if (destinationString == "No Change") {
+        return;
+    }
+
+    // Calculate whether the Agent will comply with self-enforced measures
+    bool compliance = willComply();
+
+    // Run the base destination update (allow agent's to go to random locations if they comply and there's not strong guidelines)
+    bool randomAllowed = !(compliance && policy.guidelines >= MODERATE_TIER);
+    AgentController::updateSingleDestination(agent, hour, randomAllowed);
 
-        // Calculate whether the Agent will comply with self-enforced measures
-        bool compliance = willComply();
+    // Enforce Lockdowns. Even non-compliant agents must follow lockdowns
+    enforceLockdowns(agent, home);
 
-        // Run the base destination update (allow agent's to go to random locations if they comply and there's not strong guidelines)
-        bool randomAllowed = true;
-        if (compliance && (sim->checkDebug("moderate guidelines") || sim->checkDebug("strong guidelines") ||
-                           sim->checkDebug("total lockdown"))) {
-            randomAllowed = false;
+    // Update the Agent's compliance status
+    agent->setCompliance(compliance);
+    if (!compliance) {
+        return;
+    }
+
+    // Enable an Agent to go to Work, School, or Leisure from Home. If an
+    // agent can work from home, they can get around Quarantine and Contact Tracing
+    bool workingFromHome = ECOMMERCE && applyECommerce(agent, home);
+    if (!workingFromHome) {
+        // Enforce the Quarantine when Infected Flag and update the currentLocation
+        if (QUARANTINE) {
+            enforceQuarantine(agent, home);
         }
-        AgentController::updateSingleDestination(agent, hour, randomAllowed);
 
-        // Enforce Lockdowns. Even non-compliant agents must follow lockdowns
-        enforceLockdowns(castAgent, home);
+        // Enforce the Contact Tracing Flag and update the currentLocation
+        if (CONTACT_TRACING) {
+            enforceContactTracing(agent, home);
+        }
 
-        // Update the Agent's compliance status
-        if (!compliance) {
-            castAgent->setCompliance(false);
-            return;
+        // Enfore the Government guidelines
+        if (GUIDELINES) {
+            enforceGuidelines(agent, home);
         }
+    }
+}
 
-        // Update the Agent's compliance status
-        castAgent->setCompliance(true);
 
-        // Enable an Agent to go to Work, School, or Leisure from Home. If an
-        // agent can work from home, they can get around Quarantine and Contact Tracing
-        bool workingFromHome = applyECommerce(castAgent, home);
-        if (!workingFromHome) {
-            // Enforce the Quarantine when Infected Flag and update the currentLocation
-            enforceQuarantine(castAgent, home);
+//******************************************************************************
 
-            // Enforce the Contact Tracing Flag and update the currentLocation
-            enforceContactTracing(castAgent, home);
 
-            // Enfore the Government guidelines
-            enforceGuidelines(castAgent, home);
-        }
+void PandemicController::readInterventionPolicy() {
+    policy.compliance = readTier("non-compliance");
+    policy.guidelines = readTier("guidelines");
+    policy.contactTracing = readTier("contact tracing");
+    policy.eCommerce = readTier("e-commerce");
+    policy.quarantine = sim->checkDebug("quarantine when infected");
+    policy.totalLockdown = sim->checkDebug("total lockdown");
+
+    // One kernel for each combination of enabled interventions, indexed by
+    // the bits ECOMMERCE, QUARANTINE, CONTACT_TRACING, GUIDELINES
+    static const DestinationKernel kernels[16] = {
+        &PandemicController::updateDestination<false, false, false, false>,
+        &PandemicController::updateDestination<false, false, false, true>,
+        &PandemicController::updateDestination<false, false, true, false>,
+        &PandemicController::updateDestination<false, false, true, true>,
+        &PandemicController::updateDestination<false, true, false, false>,
+        &PandemicController::updateDestination<false, true, false, true>,
+        &PandemicController::updateDestination<false, true, true, false>,
+        &PandemicController::updateDestination<false, true, true, true>,
+        &PandemicController::updateDestination<true, false, false, false>,
+        &PandemicController::updateDestination<true, false, false, true>,
+        &PandemicController::updateDestination<true, false, true, false>,
+        &PandemicController::updateDestination<true, false, true, true>,
+        &PandemicController::updateDestination<true, true, false, false>,
+        &PandemicController::updateDestination<true, true, false, true>,
+        &PandemicController::updateDestination<true, true, true, false>,
+        &PandemicController::updateDestination<true, true, true, true>
+    };
+
+    int index = ((policy.eCommerce != NO_TIER) << 3) |
+                (policy.quarantine << 2) |
+                ((policy.contactTracing != NO_TIER) << 1) |
+                (policy.guidelines != NO_TIER);
+    destinationKernel = kernels[index];
+}
+
+
+//******************************************************************************
+
+
+PandemicController::TIER PandemicController::readTier(const std::string &name) {
+    if (sim->checkDebug("strong " + name)) {
+        return STRONG_TIER;
+    } else if (sim->checkDebug("moderate " + name)) {
+        return MODERATE_TIER;
+    } else if (sim->checkDebug("weak " + name)) {
+        return WEAK_TIER;
     }
+    return NO_TIER;
 }
 
 
@@ -144,6 +223,9 @@ void PandemicController::initializePandemicUpdate(std::vector<Agent*> &agents) {
         }
     }
 
+    // Read the interventions in effect for this hour
+    readInterventionPolicy();
+
     // Update every Location if Lockdowns are enforced
     lockdownLocations();
 
@@ -166,7 +248,6 @@ void PandemicController::initializePandemicUpdate(std::vector<Agent*> &agents) {
                 numSusceptible++;
             } else if (agent->getStatus() == PandemicAgent::EXPOSED) {
                 numExposed++;
-                incrementNearbyInfected(pandemicAgents, i);
             } else if (agent->getStatus() == PandemicAgent::INFECTED) {
                 numInfected++;
                 if (agent->getLocation(Agent::HOME) == nullptr) {
@@ -183,23 +264,79 @@ void PandemicController::initializePandemicUpdate(std::vector<Agent*> &agents) {
 //******************************************************************************
 
 
-bool PandemicController::agentPandemicUpdate(PandemicAgent* agent, int i) {
-    // Update the count of each Pandemic Status
-    bool died = false;
-    if (agent->getStatus() == PandemicAgent::EXPOSED) {
-        incrementNearbyInfected(pandemicAgents, i);
-    } else if (agent->getStatus() == PandemicAgent::INFECTED) {
-        died = agent->evaluateDeathProbability(numInfected, sim->getUI()->hospitalCapacity->value());
-        if (died) {
-            sim->killAgent(agent, i);
-            pandemicAgents[i] = nullptr; // Mark the agent as dead in the pandemicAgents vectors
-            newDailyDeaths++;
-            totalDeaths++;
-        } else {
-            incrementNearbyInfected(pandemicAgents, i);
+std::vector<int> PandemicController::evaluateMortality(const std::vector<PandemicAgent*> &pandemicAgents) {
+    updateMortalityTable(sim->getHospitalCapacity());
+
+    // Gather the Infected cohort along with each Agent's odds of dying
+    std::vector<int> cohort;
+    std::vector<int> odds;
+    for (size_t i = 0; i < pandemicAgents.size(); ++i) {
+        PandemicAgent* agent = pandemicAgents[i];
+        if (agent == nullptr || agent->getStatus() != PandemicAgent::INFECTED) {continue;}
+
+        int age = std::min(std::max(agent->getAge(), 0), MORTALITY_MAX_AGE);
+        cohort.push_back(static_cast<int>(i));
+        odds.push_back(mortalityTable[age * PandemicAgent::HEALTH_MAX + agent->getHealthStatus()]);
+    }
+
+    // Draw the roll of every Agent in the cohort from a single seed for the hour
+    unsigned long long seed = (static_cast<unsigned long long>(sim->getRandom()) << 32) ^
+                              static_cast<unsigned long long>(sim->getRandom());
+    std::vector<int> deaths;
+    for (size_t j = 0; j < cohort.size(); ++j) {
+        if (getRandomRoll(seed, static_cast<size_t>(cohort[j]), 0) % odds[j] == 0) {
+            deaths.push_back(cohort[j]);
         }
     }
-    return died;
+    return deaths;
+}
+
+
+//******************************************************************************
+
+
+void PandemicController::applyMortality(std::vector<PandemicAgent*> &pandemicAgents,
+                                        const std::vector<int> &deaths) {
+    if (deaths.empty()) {
+        return;
+    }
+
+    // Mark the agents as dead in the pandemicAgents vectors
+    for (size_t i = 0; i < deaths.size(); ++i) {
+        pandemicAgents[deaths[i]] = nullptr;
+        this->pandemicAgents[deaths[i]] = nullptr;
+    }
+
+    // Remove every dead Agent from the Simulation in one step
+    sim->killAgents(deaths);
+    newDailyDeaths += static_cast<int>(deaths.size());
+    totalDeaths += static_cast<int>(deaths.size());
+}
+
+
+//******************************************************************************
+
+
+void PandemicController::updateMortalityTable(int hospitalCapacity) {
+
+    // Hospitals overflow once there are more Infected Agents than they can treat
+    int overflow = 0;
+    if (numInfected > hospitalCapacity) {
+        overflow = numInfected / std::max(hospitalCapacity, 1);
+    }
+    if (overflow == mortalityOverflow) {
+        return;
+    }
+
+    // Rebuild the odds for every age and health status
+    mortalityTable = std::vector<int>((MORTALITY_MAX_AGE + 1) * PandemicAgent::HEALTH_MAX);
+    for (int age = 0; age <= MORTALITY_MAX_AGE; ++age) {
+        for (int health = 0; health < PandemicAgent::HEALTH_MAX; ++health) {
+            mortalityTable[age * PandemicAgent::HEALTH_MAX + health] =
+                    PandemicAgent::getDeathOdds(age, static_cast<PandemicAgent::HEALTH>(health), overflow);
+        }
+    }
+    mortalityOverflow = overflow;
 }
 
 
@@ -208,22 +345,64 @@ bool PandemicController::agentPandemicUpdate(PandemicAgent* agent, int i) {
 
 void PandemicController::spreadInfection(std::vector<PandemicAgent*> &pandemicAgents) {
 
-    // Track the number of new infections each hour
-    int newExposures = 0;
+    // Count the nearby infected for each Susceptible agent
+    if (transmission == LOCATION_CONTACT) {
+        accumulateLocationContacts(pandemicAgents);
+    } else {
+        accumulateNearbyInfected(pandemicAgents);
+    }
 
-    bool guidelines = (sim->checkDebug("moderate guidelines") ||
-                       sim->checkDebug("strong guidelines"));
-    // Loop through every agent to spread the Infection
-    for (size_t i = 0; i < pandemicAgents.size(); ++i) {
-        if (pandemicAgents[i] == nullptr) {continue;}
-        bool newlyExposed = pandemicAgents[i]->evaluateInfectionProbability(checkCompliance, guidelines);
-        if (newlyExposed) {
-            numExposed++;
-            newExposures++;
-            numSusceptible--;
+    bool guidelines = (policy.guidelines >= MODERATE_TIER);
+
+    // Draw a single seed for the hour. Every Agent derives its rolls from the
+    // seed and its index, so the outcome is the same on any number of threads
+    unsigned long long seed = (static_cast<unsigned long long>(sim->getRandom()) << 32) ^
+                              static_cast<unsigned long long>(sim->getRandom());
+
+    // Split the agents into up to one chunk per thread, as long as every
+    // chunk has enough agents to be worth running on its own thread
+    size_t numThreads = static_cast<size_t>(std::max(1, QThreadPool::globalInstance()->maxThreadCount()));
+    size_t numChunks = std::max(static_cast<size_t>(1),
+                                std::min(numThreads, pandemicAgents.size() / SPREAD_CHUNK_MIN));
+    size_t chunkSize = (pandemicAgents.size() + numChunks - 1) / numChunks;
+    std::vector<SpreadChunk> chunks(numChunks);
+    for (size_t i = 0; i < numChunks; ++i) {
+        chunks[i].begin = std::min(i * chunkSize, pandemicAgents.size());
+        chunks[i].end = std::min((i + 1) * chunkSize, pandemicAgents.size());
+    }
+
+    // Loop through every agent in a chunk to spread the Infection
+    bool compliance = checkCompliance;
+    auto evaluateChunk = [&pandemicAgents, compliance, guidelines, seed](SpreadChunk &chunk) {
+        for (size_t i = chunk.begin; i < chunk.end; ++i) {
+            if (pandemicAgents[i] == nullptr) {continue;}
+            bool newlyExposed = pandemicAgents[i]->evaluateInfectionProbability(compliance, guidelines,
+                                                                                getRandomRoll(seed, i, 0),
+                                                                                getRandomRoll(seed, i, 1));
+            if (newlyExposed) {
+                chunk.newlyExposed.push_back(pandemicAgents[i]);
+            }
         }
+    };
+
+    if (numChunks == 1) {
+        evaluateChunk(chunks[0]);
+    } else {
+        QtConcurrent::blockingMap(chunks, evaluateChunk);
     }
 
+    // Reduce the new exposures found by each chunk, scheduling them in index
+    // order so the calendar does not depend on the number of threads
+    int newExposures = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        for (size_t j = 0; j < chunks[i].newlyExposed.size(); ++j) {
+            scheduleTransition(chunks[i].newlyExposed[j]);
+        }
+        newExposures += static_cast<int>(chunks[i].newlyExposed.size());
+    }
+    numExposed += newExposures;
+    numSusceptible -= newExposures;
+
     // Update the attributes for the Simulation state
     last24Exposed.pop_front();
     last24Exposed.push_back(newExposures);
@@ -235,7 +414,7 @@ void PandemicController::spreadInfection(std::vector<PandemicAgent*> &pandemicAg
 
 void PandemicController::spontaneousInfection() {
     if (numExposed == 0 && numInfected == 0 && numSusceptible > 0) {
-        if (rand() % 600 == 0) {
+        if (sim->getRandom() % 600 == 0) {
             initialInfection = false;
         }
     }
@@ -248,16 +427,70 @@ void PandemicController::spontaneousInfection() {
 void PandemicController::advanceDay() {
     this->newDailyCases = 0;
     this->newDailyDeaths = 0;
+    ++currentDay;
 
-    // Advance the infection for each Agent
-    std::vector<Agent*> agents = sim->getAgents();
-    for (size_t i = 0; i < agents.size(); ++i) {
-        PandemicAgent* agent = dynamic_cast<PandemicAgent*>(agents[i]);
-        bool newCase = agent->advanceDay();
+    // Take the transitions due today out of the calendar
+    std::vector<PandemicAgent*> due;
+    due.swap(transitionCalendar[currentDay % CALENDAR_DAYS]);
+
+    // Advance the infection for each Agent with a transition due today
+    for (size_t i = 0; i < due.size(); ++i) {
+        PandemicAgent* agent = due[i];
+        bool newCase = agent->advanceStage();
         if (newCase) {
             newDailyCases++;
             totalCases++;
         }
+        scheduleTransition(agent);
+    }
+}
+
+
+//******************************************************************************
+
+
+void PandemicController::scheduleTransition(PandemicAgent* agent) {
+
+    // Drop any transition the Agent already has pending
+    unscheduleTransition(agent);
+
+    // Susceptible Agents have nothing to schedule
+    int stageLength = agent->sampleStageLength();
+    if (stageLength < 0) {
+        agent->setTransitionDay(-1);
+        return;
+    }
+
+    int day = currentDay + stageLength;
+    agent->setTransitionDay(day);
+    transitionCalendar[day % CALENDAR_DAYS].push_back(agent);
+}
+
+
+//******************************************************************************
+
+
+void PandemicController::unscheduleTransition(PandemicAgent* agent) {
+
+    // Transitions due today have already been taken out of the calendar
+    int day = agent->getTransitionDay();
+    if (day <= currentDay) {
+        return;
+    }
+
+    std::vector<PandemicAgent*> &bucket = transitionCalendar[day % CALENDAR_DAYS];
+    bucket.erase(std::remove(bucket.begin(), bucket.end(), agent), bucket.end());
+    agent->setTransitionDay(-1);
+}
+
+
+//******************************************************************************
+
+
+void PandemicController::removeAgent(Agent* victim) {
+    PandemicAgent* agent = dynamic_cast<PandemicAgent*>(victim);
+    if (agent != nullptr) {
+        unscheduleTransition(agent);
     }
 }
 
@@ -289,6 +522,14 @@ int PandemicController::getTotalDeaths() {
 //******************************************************************************
 
 
+bool PandemicController::hasInfectionBegun() {
+    return this->initialInfection;
+}
+
+
+//******************************************************************************
+
+
 int PandemicController::getDailyDeaths() {
     return this->newDailyDeaths;
 }
@@ -313,9 +554,10 @@ void PandemicController::beginInfection() {
     std::vector<Agent*> agents = sim->getAgents();
 
     for (int i = 0; i < numToInfect; ++i) {
-        int randIndex = rand() % agents.size();
+        int randIndex = sim->getRandom() % agents.size();
         PandemicAgent* agent = dynamic_cast<PandemicAgent*>(agents[randIndex]);
         agent->makeExposed();
+        scheduleTransition(agent);
     }
 }
 
@@ -332,7 +574,7 @@ void PandemicController::enforceLockdowns(PandemicAgent* agent, Location* home)
     }
 
     // If there's a total lockdown, immediately send all agents home
-    if (sim->checkDebug("total lockdown")) {
+    if (policy.totalLockdown) {
         agent->setDestination(*home, "Home");
         return;
     }
@@ -358,7 +600,7 @@ void PandemicController::enforceLockdowns(PandemicAgent* agent, Location* home)
 
 
 void PandemicController::enforceQuarantine(PandemicAgent* agent, Location* home) {
-    if (sim->checkDebug("quarantine when infected")) {
+    if (policy.quarantine) {
         if (agent->getStatus() == PandemicAgent::INFECTED) {
             agent->setDestination(*home, "Home");
         }
@@ -369,35 +611,25 @@ void PandemicController::enforceQuarantine(PandemicAgent* agent, Location* home)
 //******************************************************************************
 
 
-void PandemicController::enforceContactTracing(PandemicAgent* agent, Location* home_in) {
-
-    PandemicLocation* home = dynamic_cast<PandemicLocation*>(agent->getLocation(Agent::HOME));
-    PandemicLocation* work = dynamic_cast<PandemicLocation*>(agent->getLocation(Agent::WORK));
-    PandemicLocation* school = dynamic_cast<PandemicLocation*>(agent->getLocation(Agent::SCHOOL));
-    PandemicLocation* leisure = dynamic_cast<PandemicLocation*>(agent->getLocation(Agent::LEISURE));
+void PandemicController::enforceContactTracing(PandemicAgent* agent, Location* home) {
 
-    if (sim->checkDebug("weak contact tracing") ||
-            sim->checkDebug("moderate contact tracing") ||
-            sim->checkDebug("strong contact tracing")) {
+    if (policy.contactTracing != NO_TIER) {
 
         // Determine if the Agent has been exposed at any of their locations
-        bool exposed = ((home && home->getNumInfectedAgents() > 0) ||
-                        (home == nullptr && numHomelessInfected > 0) ||
-                        (work && work->getNumInfectedAgents() > 0) ||
-                        (school && school->getNumInfectedAgents() > 0) ||
-                        (leisure && leisure->getNumInfectedAgents() > 0));
+        bool exposed = (agent->hasExposedLocation() ||
+                        (agent->getLocation(Agent::HOME) == nullptr && numHomelessInfected > 0));
 
         // Enforce the probabilities of each option
         if (exposed) {
-            if (sim->checkDebug("strong contact tracing")) {
-                agent->setDestination(*home_in, "Home");
-            } else if (sim->checkDebug("moderate contact tracing")) {
-                if (rand() % 4 != 3) {
-                    agent->setDestination(*home_in, "Home");
+            if (policy.contactTracing == STRONG_TIER) {
+                agent->setDestination(*home, "Home");
+            } else if (policy.contactTracing == MODERATE_TIER) {
+                if (sim->getRandom() % 4 != 3) {
+                    agent->setDestination(*home, "Home");
                 }
-            } else if (sim->checkDebug("weak contact tracing")) {
-                if (rand() % 2 == 0) {
-                    agent->setDestination(*home_in, "Home");
+            } else if (policy.contactTracing == WEAK_TIER) {
+                if (sim->getRandom() % 2 == 0) {
+                    agent->setDestination(*home, "Home");
                 }
             }
         }
@@ -410,12 +642,12 @@ void PandemicController::enforceContactTracing(PandemicAgent* agent, Location* h
 
 bool PandemicController::willComply() {
 
-    if (sim->checkDebug("strong non-compliance")) {
-        return (rand() % 2) != 0; // 50/50 chance to comply
-    } else if (sim->checkDebug("moderate non-compliance")) {
-        return (rand() % 4) != 0; // 75/25 chance to comply
-    } else if (sim->checkDebug("weak non-compliance")) {
-        return (rand() % 8) != 0; // 87.5/12.5 chance to comply
+    if (policy.compliance == STRONG_TIER) {
+        return (sim->getRandom() % 2) != 0; // 50/50 chance to comply
+    } else if (policy.compliance == MODERATE_TIER) {
+        return (sim->getRandom() % 4) != 0; // 75/25 chance to comply
+    } else if (policy.compliance == WEAK_TIER) {
+        return (sim->getRandom() % 8) != 0; // 87.5/12.5 chance to comply
     }
 
     return true;
@@ -433,19 +665,19 @@ void PandemicController::enforceGuidelines(PandemicAgent *agent, Location *home)
         return;
     }
 
-    if (sim->checkDebug("strong guidelines")) {
+    if (policy.guidelines == STRONG_TIER) {
         // Have a 50% chance of going to a Leisure location
-        if ((rand() % 2) != 0) {
+        if ((sim->getRandom() % 2) != 0) {
             agent->setDestination(*home, "Home");
         }
-    } else if (sim->checkDebug("moderate guidelines")) {
+    } else if (policy.guidelines == MODERATE_TIER) {
         // Have a 60% chance of going to a Leisure location
-        if ((rand() % 10) < 6) {
+        if ((sim->getRandom() % 10) < 6) {
             agent->setDestination(*home, "Home");
         }
-    } else if (sim->checkDebug("weak guidelines")) {
+    } else if (policy.guidelines == WEAK_TIER) {
         // Have a 75% chance of going to a Leisure location
-        if ((rand() % 4) == 0) {
+        if ((sim->getRandom() % 4) == 0) {
             agent->setDestination(*home, "home");
         }
     }
@@ -466,21 +698,21 @@ bool PandemicController::applyECommerce(PandemicAgent *agent, Location *home) {
 
     // Send the Agent home, but make it appear to be at the other Location from an Economic Standpoint
     bool workingFromHome = false;
-    if (sim->checkDebug("strong e-commerce")) {
+    if (policy.eCommerce == STRONG_TIER) {
         // Give the Agent a 75% chance each hour to work from Home
-        if ((rand() % 100) < 75) {
+        if ((sim->getRandom() % 100) < 75) {
             agent->setDestination(*home, agent->getDestinationString());
             workingFromHome = true;
         }
-    } else if (sim->checkDebug("moderate e-commerce")) {
+    } else if (policy.eCommerce == MODERATE_TIER) {
         // Give the Agent an 50% chance each hour to work from Home
-        if ((rand() % 100) < 50) {
+        if ((sim->getRandom() % 100) < 50) {
             agent->setDestination(*home, agent->getDestinationString());
             workingFromHome = true;
         }
-    } else if (sim->checkDebug("weak e-commerce")) {
+    } else if (policy.eCommerce == WEAK_TIER) {
         // Give the Agent an 25% chance each hour to work from Home
-        if ((rand() % 100) < 25) {
+        if ((sim->getRandom() % 100) < 25) {
             agent->setDestination(*home, agent->getDestinationString());
             workingFromHome = true;
         }
@@ -494,70 +726,228 @@ bool PandemicController::applyECommerce(PandemicAgent *agent, Location *home) {
 
 
 void PandemicController::lockdownLocations() {
-    // Update every Location if Lockdowns are enforced
-    std::vector<Location*> locations = sim->getAllLocations();
-    for (size_t i = 0; i < locations.size(); ++i) {
-        // Get the Location and calculate the infected proportion
-        PandemicLocation* location = dynamic_cast<PandemicLocation*>(locations[i]);
-        double infectedProportion = static_cast<double>(location->getNumInfectedAgents()) / location->getNumAgents();
-
-        // Home locations cannot go on lockdown
-        if (location->getType() == Agent::HOME) {
-            if (location->getNumInfectedAgents() > 0) {
-                location->setStatus(PandemicLocation::EXPOSURE);
-            } else {
-                location->setStatus(PandemicLocation::NORMAL);
-            }
-            continue;
-        }
 
-        if (sim->checkDebug("total lockdown")) {
-            location->setStatus(PandemicLocation::LOCKDOWN);
-            continue;
-        } else if (sim->checkDebug("strong lockdown")) {
-            if (infectedProportion > 0.20) {
-                location->setStatus(PandemicLocation::LOCKDOWN);
-                continue;
-            }
-        } else if (sim->checkDebug("moderate lockdown")) {
-            if (infectedProportion > 0.35) {
-                location->setStatus(PandemicLocation::LOCKDOWN);
-                continue;
-            }
-        } else if (sim->checkDebug("weak lockdown")) {
-            if (infectedProportion > 0.75) {
-                location->setStatus(PandemicLocation::LOCKDOWN);
-                continue;
+    // A change in policy can affect every Location, so re-evaluate them all
+    LOCKDOWN policy = getLockdownPolicy();
+    QMutexLocker lock(&staleLock);
+    if (policy != lockdownPolicy) {
+        lockdownPolicy = policy;
+        std::vector<Location*> locations = sim->getAllLocations();
+        staleLocations.insert(locations.begin(), locations.end());
+    }
+
+    // Re-evaluate the stale Locations. Updating one Location can mark another
+    // as stale, so continue until none are left
+    while (!staleLocations.empty()) {
+        std::vector<Location*> stale(staleLocations.begin(), staleLocations.end());
+        staleLocations.clear();
+        lock.unlock();
+
+        for (size_t i = 0; i < stale.size(); ++i) {
+            PandemicLocation* location = dynamic_cast<PandemicLocation*>(stale[i]);
+            if (location != nullptr) {
+                updateLockdownStatus(location, policy);
             }
         }
+        lock.relock();
+    }
+}
+
 
+//******************************************************************************
+
+
+void PandemicController::updateLockdownStatus(PandemicLocation* location, LOCKDOWN policy) {
+
+    // Calculate the infected proportion
+    double infectedProportion = static_cast<double>(location->getNumInfectedAgents()) / location->getNumAgents();
+
+    // Home locations cannot go on lockdown
+    if (location->getType() == Agent::HOME) {
         if (location->getNumInfectedAgents() > 0) {
             location->setStatus(PandemicLocation::EXPOSURE);
         } else {
             location->setStatus(PandemicLocation::NORMAL);
         }
+        return;
     }
+
+    if (policy == TOTAL_LOCKDOWN) {
+        location->setStatus(PandemicLocation::LOCKDOWN);
+        return;
+    } else if (policy != NO_LOCKDOWN && infectedProportion > getLockdownThreshold(policy)) {
+        location->setStatus(PandemicLocation::LOCKDOWN);
+        return;
+    }
+
+    if (location->getNumInfectedAgents() > 0) {
+        location->setStatus(PandemicLocation::EXPOSURE);
+    } else {
+        location->setStatus(PandemicLocation::NORMAL);
+    }
+}
+
+
+//******************************************************************************
+
+
+PandemicController::LOCKDOWN PandemicController::getLockdownPolicy() {
+    if (sim->checkDebug("total lockdown")) {
+        return TOTAL_LOCKDOWN;
+    } else if (sim->checkDebug("strong lockdown")) {
+        return STRONG_LOCKDOWN;
+    } else if (sim->checkDebug("moderate lockdown")) {
+        return MODERATE_LOCKDOWN;
+    } else if (sim->checkDebug("weak lockdown")) {
+        return WEAK_LOCKDOWN;
+    }
+    return NO_LOCKDOWN;
+}
+
+
+//******************************************************************************
+
+
+double PandemicController::getLockdownThreshold(LOCKDOWN policy) {
+    if (policy == STRONG_LOCKDOWN) {
+        return 0.20;
+    } else if (policy == MODERATE_LOCKDOWN) {
+        return 0.35;
+    }
+    return 0.75;
+}
+
+
+//******************************************************************************
+
+
+void PandemicController::locationChanged(Location* location) {
+    QMutexLocker lock(&staleLock);
+    staleLocations.insert(location);
+}
+
+
+//******************************************************************************
+
+
+void PandemicController::removeLocation(Location* victim) {
+    QMutexLocker lock(&staleLock);
+    staleLocations.erase(victim);
+}
+
+
+//**************************************************************************
+
+
+unsigned long long PandemicController::getInfectionCell(Coordinate position) {
+    long long cellX = static_cast<long long>(std::floor(position.getCoord(Coordinate::X) / INFECTION_RADIUS));
+    long long cellY = static_cast<long long>(std::floor(position.getCoord(Coordinate::Y) / INFECTION_RADIUS));
+    return getCellKey(cellX, cellY);
 }
 
 
 //**************************************************************************
 
 
-void PandemicController::incrementNearbyInfected(std::vector<PandemicAgent*> &pandemicAgents, size_t index) {
+unsigned long long PandemicController::getCellKey(long long cellX, long long cellY) {
+    return (static_cast<unsigned long long>(cellX) << 32) ^
+           (static_cast<unsigned long long>(cellY) & 0xFFFFFFFFULL);
+}
+
+
+//**************************************************************************
+
+
+void PandemicController::accumulateNearbyInfected(std::vector<PandemicAgent*> &pandemicAgents) {
+
+    // Bin every Exposed and Infected agent by the cell it's in. Cells are as
+    // wide as the infection radius, so every agent within the radius of a
+    // position lies in that position's cell or one of its eight neighbors
+    std::unordered_map<unsigned long long, std::vector<InfectiousAgent>> cells;
+    for (size_t i = 0; i < pandemicAgents.size(); ++i) {
+        if (pandemicAgents[i] == nullptr) {continue;}
+
+        PandemicAgent::STATUS status = pandemicAgents[i]->getStatus();
+        if (status != PandemicAgent::EXPOSED && status != PandemicAgent::INFECTED) {continue;}
+
+        InfectiousAgent infectious = {pandemicAgents[i]->getPosition(), i,
+                                      status == PandemicAgent::INFECTED};
+        cells[getInfectionCell(infectious.position)].push_back(infectious);
+    }
+
+    // Nothing to spread if no Agents are infectious
+    if (cells.empty()) {
+        return;
+    }
+
+    // Gather the weighted infectious neighbors of each Susceptible agent. Each
+    // agent only writes to itself, so the sweep has no write conflicts
+    for (size_t i = 0; i < pandemicAgents.size(); ++i) {
+        if (pandemicAgents[i] == nullptr) {continue;}
+        if (pandemicAgents[i]->getStatus() != PandemicAgent::SUSCEPTIBLE) {continue;}
+
+        Coordinate position = pandemicAgents[i]->getPosition();
+        long long cellX = static_cast<long long>(std::floor(position.getCoord(Coordinate::X) / INFECTION_RADIUS));
+        long long cellY = static_cast<long long>(std::floor(position.getCoord(Coordinate::Y) / INFECTION_RADIUS));
+
+        int nearby = 0;
+        for (long long x = cellX - 1; x <= cellX + 1; ++x) {
+            for (long long y = cellY - 1; y <= cellY + 1; ++y) {
+                auto cell = cells.find(getCellKey(x, y));
+                if (cell == cells.end()) {continue;}
+
+                for (InfectiousAgent& infectious : cell->second) {
+                    if (infectious.position.distBetween(position) >= INFECTION_RADIUS) {continue;}
+
+                    // Infected agents count twice. Exposed agents count once,
+                    // plus once more when they come later in the Agents vector,
+                    // which matches the counts of the former two-pass scan
+                    if (infectious.infected) {
+                        nearby += 2;
+                    } else {
+                        nearby += 1 + (infectious.index > i);
+                    }
+                }
+            }
+        }
+
+        pandemicAgents[i]->incrementNearbyInfected(nearby);
+    }
+}
+
 
-    // Grab the position of the Agent to compare against
-    Coordinate comparisonPosition = pandemicAgents[index]->getPosition();
-    bool isInfected = pandemicAgents[index]->getStatus() == PandemicAgent::INFECTED;
+//**************************************************************************
 
+
+void PandemicController::accumulateLocationContacts(std::vector<PandemicAgent*> &pandemicAgents) {
+
+    // Total the infectious weight heading to each Location, keyed by ID since
+    // a Location can close while Agents are still heading to it
+    std::unordered_map<int, int> infectiousWeight;
     for (size_t i = 0; i < pandemicAgents.size(); ++i) {
-        if (i == index) {continue;}
         if (pandemicAgents[i] == nullptr) {continue;}
 
-        Coordinate agentPosition = pandemicAgents[i]->getPosition();
-        double distance = comparisonPosition.distBetween(agentPosition);
+        PandemicAgent::STATUS status = pandemicAgents[i]->getStatus();
+        if (status == PandemicAgent::EXPOSED) {
+            infectiousWeight[pandemicAgents[i]->getDestinationID()] += EXPOSED_CONTACT_WEIGHT;
+        } else if (status == PandemicAgent::INFECTED) {
+            infectiousWeight[pandemicAgents[i]->getDestinationID()] += INFECTED_CONTACT_WEIGHT;
+        }
+    }
+
+    // Nothing to spread if no Agents are infectious
+    if (infectiousWeight.empty()) {
+        return;
+    }
+
+    // Give each Susceptible Agent the total weight at its Location
+    for (size_t i = 0; i < pandemicAgents.size(); ++i) {
+        if (pandemicAgents[i] == nullptr) {continue;}
+        if (pandemicAgents[i]->getStatus() != PandemicAgent::SUSCEPTIBLE) {continue;}
 
-        if (distance < INFECTION_RADIUS) {
-            pandemicAgents[i]->incrementNearbyInfected(1 + isInfected);
+        auto it = infectiousWeight.find(pandemicAgents[i]->getDestinationID());
+        if (it != infectiousWeight.end()) {
+            pandemicAgents[i]->incrementNearbyInfected(it->second);
         }
     }
 }
@@ -566,6 +956,14 @@ void PandemicController::incrementNearbyInfected(std::vector<PandemicAgent*> &pa
 //**************************************************************************
 
 
+PandemicController::TRANSMISSION PandemicController::getTransmission() {
+    return this->transmission;
+}
+
+
+//**************************************************************************
+
+
 std::vector<PandemicAgent*>& PandemicController::getPandemicAgents() {
     return pandemicAgents;
 }
@@ -591,7 +989,7 @@ std::vector<double> PandemicController::getState() {
                                  static_cast<double>(numExposed) / sim->getCurrentNumAgents() * 100,
                                  static_cast<double>(numRecovered) / sim->getCurrentNumAgents() * 100,
                                  static_cast<double>(numSusceptible) / sim->getCurrentNumAgents() * 100,
-                                 static_cast<double>(numInfected > sim->getUI()->hospitalCapacity->value() * 100)});
+                                 static_cast<double>(numInfected > sim->getHospitalCapacity() * 100)});
 }
 
 
@@ -1,4 +1,5 @@
 #include "Headers/PandemicLocation.h"
+#include "Headers/PandemicAgent.h"
 
 PandemicLocation::PandemicLocation(double x, double y, Agent::LOCATIONS type) :
     Location(x, y) {
@@ -23,8 +24,12 @@ Agent::LOCATIONS PandemicLocation::getType() {
 
 void PandemicLocation::addInfectedAgent() {
     numInfectedAgents++;
+    markChanged();
+    if (numInfectedAgents == 1) {
+        updateAgentExposure();
+    }
     if (pandemicStatus != PandemicLocation::LOCKDOWN) {
-        pandemicStatus = PandemicLocation::EXPOSURE;
+        setStatus(PandemicLocation::EXPOSURE);
     }
 }
 
@@ -34,8 +39,34 @@ void PandemicLocation::addInfectedAgent() {
 
 void PandemicLocation::removeInfectedAgent() {
     numInfectedAgents--;
+    markChanged();
     if (numInfectedAgents == 0) {
-        pandemicStatus = PandemicLocation::NORMAL;
+        setStatus(PandemicLocation::NORMAL);
+        updateAgentExposure();
+    }
+}
+
+
+//******************************************************************************
+
+
+void PandemicLocation::updateAgentExposure() {
+    bool exposed = numInfectedAgents > 0;
+
+    // Agents are not always removed from a Location when they leave it, so
+    // only update the slots that still point at this Location
+    std::unordered_set<Agent*> agents = getAgents();
+    for (auto it = agents.begin(); it != agents.end(); ++it) {
+        PandemicAgent* agent = dynamic_cast<PandemicAgent*>(*it);
+        if (agent == nullptr) {
+            continue;
+        }
+        for (int i = 0; i < Agent::LOCATIONS_MAX; ++i) {
+            Agent::LOCATIONS which = static_cast<Agent::LOCATIONS>(i);
+            if (agent->getLocation(which) == this) {
+                agent->setLocationExposure(which, exposed);
+            }
+        }
     }
 }
 
@@ -60,13 +91,24 @@ PandemicLocation::STATUS PandemicLocation::getStatus() {
 
 
 void PandemicLocation::setStatus(PandemicLocation::STATUS newStatus) {
-    this->pandemicStatus = newStatus;
+    if (newStatus != pandemicStatus) {
+        PandemicLocation::STATUS previousStatus = pandemicStatus;
+        this->pandemicStatus = newStatus;
+        markDirty();
+        statusChanged(previousStatus);
+    }
 }
 
 
 //******************************************************************************
 
 
+void PandemicLocation::statusChanged(PandemicLocation::STATUS) {}
+
+
+//******************************************************************************
+
+
 PandemicLocation::~PandemicLocation() {}
 
 
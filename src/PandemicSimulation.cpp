@@ -2,12 +2,15 @@
 
 
 PandemicSimulation::PandemicSimulation(int lagPeriod, int initialInfected, int initialValue, int numAgents,
-                                       Ui::MainWindow* ui, std::map<std::string, bool> debug) :
-    EconomicSimulation(initialValue, numAgents, ui, debug) {
+                                       Ui::MainWindow* ui, std::map<std::string, bool> debug,
+                                       const SimulationSettings* settings) :
+    EconomicSimulation(initialValue, numAgents, ui, debug, settings) {
 
     // Initialize parameters of Simulation
     this->lagPeriod = lagPeriod;
     this->initialInfected = initialInfected;
+    this->numFrames = 0;
+    this->fastForwarded = false;
 
     // Initialize the chart helpers
     SEIRHelper = new SEIRChartHelper();
@@ -29,15 +32,20 @@ PandemicSimulation::PandemicSimulation(int lagPeriod, int initialInfected, int i
 
 void PandemicSimulation::execute() {
 
-    // Static counter to determine if an hour has passed
-    static int numFrames = 0;
-
     // Cast the AgentController to a PandemicController
     PandemicController* controller = dynamic_cast<PandemicController*>(getController());
 
     // Update the Debug information in the Simulation
     updateDebug();
 
+    // Before the outbreak, skip straight to the end of the hour. Destinations,
+    // births, ages, and the economy still advance every hour
+    fastForwarded = canFastForward();
+    if (fastForwarded) {
+        skipToEndOfHour();
+        numFrames = FRAMES_PER_HOUR;
+    }
+
     // SIMPLESIMULATION::EXECUTE ***********************************************
     // Advance the time in the Simulation and update the Agent's destinations
     advanceTime();
@@ -51,10 +59,17 @@ void PandemicSimulation::execute() {
         numRecovered = SEIR[PandemicAgent::RECOVERED];
     }
 
-    // Advance time for each agent
+    // Advance time for each agent. While fast-forwarding, Agents do not move
+    // until the outbreak is about to begin, then jump to their destinations
     std::vector<Agent*> agents = getAgents();
-    for (int i = 0; i < getCurrentNumAgents(); ++i) {
-        agents[i]->takeTimeStep();
+    if (!fastForwarded) {
+        for (int i = 0; i < getCurrentNumAgents(); ++i) {
+            agents[i]->takeTimeStep();
+        }
+    } else if (!canFastForward()) {
+        for (int i = 0; i < getCurrentNumAgents(); ++i) {
+            agents[i]->arriveAtDestination();
+        }
     }
 
     // Every hour update the SEIR Chart
@@ -69,8 +84,10 @@ void PandemicSimulation::execute() {
         }
 
         // Update the total counts on the UI
-        getUI()->totalCases->setText(QString::number(controller->getTotalCases()));
-        getUI()->totalDeaths->setText(QString::number(controller->getTotalDeaths()));
+        if (getUI() != nullptr) {
+            getUI()->totalCases->setText(QString::number(controller->getTotalCases()));
+            getUI()->totalDeaths->setText(QString::number(controller->getTotalDeaths()));
+        }
     }
 
     // Update the Frame Counter
@@ -107,11 +124,12 @@ void PandemicSimulation::renderChartUpdates(QString which, bool newChartView) {
     }
 
     if (which == "SEIR") {
+        SimulationStats stats = getStats();
         if (newChartView) {
-            QtCharts::QChart* chart = SEIRHelper->getChart(getNumSEIR(), getCurrentNumAgents());
+            QtCharts::QChart* chart = SEIRHelper->getChart(stats.SEIRCounts, stats.numAgents);
             addChartToView(chart, graphView);
         } else {
-            SEIRHelper->updateChart(getNumSEIR(), getCurrentNumAgents());
+            SEIRHelper->updateChart(stats.SEIRCounts, stats.numAgents);
         }
     } else if (which == "DAILY TRACKER") {
         PandemicController* controller = dynamic_cast<PandemicController*>(getController());
@@ -140,6 +158,20 @@ std::vector<int> PandemicSimulation::getNumSEIR() {
 //******************************************************************************
 
 
+void PandemicSimulation::collectAgentStats(Agent* agent, SimulationStats &stats) {
+    EconomicSimulation::collectAgentStats(agent, stats);
+
+    // Count the Agent in its Pandemic status
+    PandemicAgent* pandemicAgent = dynamic_cast<PandemicAgent*>(agent);
+    if (pandemicAgent != nullptr) {
+        stats.SEIRCounts[pandemicAgent->getStatus()]++;
+    }
+}
+
+
+//******************************************************************************
+
+
 int PandemicSimulation::getLagPeriod() {
     return this->lagPeriod;
 }
@@ -148,6 +180,34 @@ int PandemicSimulation::getLagPeriod() {
 //******************************************************************************
 
 
+bool PandemicSimulation::canFastForward() {
+    if (!checkDebug("fast forward lag")) {
+        return false;
+    }
+
+    // Nothing is left to skip once the virus has been introduced
+    PandemicController* controller = dynamic_cast<PandemicController*>(getController());
+    if (controller == nullptr || controller->hasInfectionBegun()) {
+        return false;
+    }
+
+    // Stop before the hour in which the initial infection will happen
+    int nextHour = (getYear() * 365 + getDay()) * 24 + getHour() + 1;
+    return nextHour < getLagPeriod() * 24;
+}
+
+
+//******************************************************************************
+
+
+bool PandemicSimulation::wasFastForwarded() {
+    return this->fastForwarded;
+}
+
+
+//******************************************************************************
+
+
 int PandemicSimulation::getInitialInfected() {
     return this->initialInfected;
 }
@@ -194,8 +254,8 @@ void PandemicSimulation::renderAgentUpdate() {
     // Lock the screen and Location vectors
     QMutexLocker locationsLock(getLocationLock());
 
-    // Update the colors of each Location accordingly
-    std::vector<Location*> locations = getAllLocations();
+    // Update the colors of each Location whose status changed
+    std::vector<Location*> locations = takeDirtyLocations();
     for (size_t i = 0; i < locations.size(); ++i) {
         PandemicLocation* location = dynamic_cast<PandemicLocation*>(locations[i]);
 
@@ -220,10 +280,12 @@ void PandemicSimulation::renderAgentUpdate() {
     }
 
     // Currently only update Agents colors based on their pandemic status
-    std::vector<Agent*> agents = getAgents();
+    std::vector<Agent*> agents = takeDirtyAgents();
     for (size_t i = 0; i < agents.size(); ++i) {
         PandemicAgent* agent = dynamic_cast<PandemicAgent*>(agents[i]);
 
+        if (agent == nullptr) continue;
+
         PandemicAgent::STATUS status = agent->getStatus();
         if (status == PandemicAgent::SUSCEPTIBLE) {
             agent->setColor(SUSCEPTIBLECOLOR);
@@ -243,7 +305,7 @@ void PandemicSimulation::renderAgentUpdate() {
 
 void PandemicSimulation::renderCharts(const QString &which, bool newChartView) {
 
-    if (getUI()->headlessMode->checkState() == Qt::CheckState::Checked) {
+    if (isHeadless()) {
         return;
     }
 
@@ -51,7 +51,8 @@ void Region::generateLocations(int num, std::string type) {
         } else if (type == "Economic") {
             locations.push_back(new EconomicLocation(coord.getCoord(Coordinate::X),
                                                      coord.getCoord(Coordinate::Y),
-                                                     this->type));
+                                                     this->type,
+                                                     sim->getRandom()));
         } else if (type == "Pandemic") {
             locations.push_back(new PandemicLocation(coord.getCoord(Coordinate::X),
                                                      coord.getCoord(Coordinate::Y),
@@ -59,9 +60,15 @@ void Region::generateLocations(int num, std::string type) {
         } else if (type == "Dual") {
             locations.push_back(new DualLocation(coord.getCoord(Coordinate::X),
                                                  coord.getCoord(Coordinate::Y),
-                                                 this->type));
+                                                 this->type,
+                                                 sim->getRandom()));
         }
 
+        // Ensure the new location is colored on the next frame and has its
+        // status evaluated by the controller
+        locations.back()->setSimulation(sim);
+        locations.back()->markDirty();
+        locations.back()->markChanged();
     }
 }
 
@@ -97,7 +104,7 @@ Location* Region::getRandomLocation() {
     if (locations.size() == 0) {
         return nullptr;
     }
-    return locations[rand() % locations.size()];
+    return locations[sim->getRandom() % locations.size()];
 }
 
 
@@ -110,17 +117,14 @@ Coordinate Region::getRandomCoordinate() {
     QRectF regionBound = getGraphicsObject()->boundingRect();
     QGraphicsItem* regionGraphics = getGraphicsObject();
 
-    // Create random distributions in the range [10, regionBound-10)
-    std::uniform_int_distribution<int> xdist(10,
-                                            regionBound.width() - 10);
-    std::uniform_int_distribution<int> ydist(10,
-                                             regionBound.height() - 10);
-    std::random_device rand;
-
+    // Draw coordinates in the range [10, regionBound-10] from the
+    // Simulation's engine so Location placement follows the seed
+    int xrange = std::max(1, static_cast<int>(regionBound.width()) - 19);
+    int yrange = std::max(1, static_cast<int>(regionBound.height()) - 19);
 
     while(true) {
-        int randx = xdist(rand);
-        int randy = ydist(rand);
+        int randx = 10 + sim->getRandom() % xrange;
+        int randy = 10 + sim->getRandom() % yrange;
 
         QPointF check(randx + regionGraphics->boundingRect().topLeft().x(),
                       randy + regionGraphics->boundingRect().topLeft().y());
@@ -146,6 +150,8 @@ void Region::removeLocation(Location *victim) {
 
     // Add the graphics object to the remove queue
     sim->addToRemoveQueue(victim->getGraphicsObject());
+    sim->unmarkDirty(victim);
+    sim->getController()->removeLocation(victim);
 
     // Swap the victim to the back and delete it
     auto it = std::find_if(locations.begin(), locations.end(), Location_Comparator(victim));
@@ -159,6 +165,36 @@ void Region::removeLocation(Location *victim) {
 //******************************************************************************
 
 
+void Region::removeLocations(const std::vector<Location*> &victims) {
+    if (victims.empty()) {
+        return;
+    }
+
+    // Take every victim off the screen at once and release it from the controller
+    QVector<QGraphicsItem*> items;
+    for (size_t i = 0; i < victims.size(); ++i) {
+        items.push_back(victims[i]->getGraphicsObject());
+        sim->unmarkDirty(victims[i]);
+        sim->getController()->removeLocation(victims[i]);
+    }
+    sim->addToRemoveQueue(items);
+
+    // Close the gaps in a single pass
+    std::unordered_set<Location*> removed(victims.begin(), victims.end());
+    locations.erase(std::remove_if(locations.begin(), locations.end(),
+                                   [&removed](Location* location) {
+        return removed.count(location) > 0;
+    }), locations.end());
+
+    for (size_t i = 0; i < victims.size(); ++i) {
+        delete victims[i];
+    }
+}
+
+
+//******************************************************************************
+
+
 QGraphicsItem* Region::getGraphicsObject() {
     return this->graphicsObject;
 }
@@ -5,8 +5,9 @@
 #include "Headers/DualAgent.h"
 
 SimpleSimulation::SimpleSimulation(int numAgents, Ui::MainWindow* ui,
-                                   std::map<std::string, bool> debug) :
-    Simulation(numAgents, ui, debug) {
+                                   std::map<std::string, bool> debug,
+                                   const SimulationSettings* settings) :
+    Simulation(numAgents, ui, debug, settings) {
 
     // Create four square regions (Home, Work, School, Leisure)
     this->homeRegion = new SquareRegion(this,
@@ -150,9 +151,9 @@ void SimpleSimulation::generateAgents(int num, bool birth, std::string type) {
     int adultBehaviors = getController()->getNumAdultBehaviors();
     int childBehaviors = getController()->getNumChildBehaviors();
     for (int i = 0; i < adultBehaviors + childBehaviors; ++i) {
-        agentColors.push_back(QColor(rand() % 256,
-                                     rand() % 256,
-                                     rand() % 256));
+        agentColors.push_back(QColor(getRandom() % 256,
+                                     getRandom() % 256,
+                                     getRandom() % 256));
     }
 
     // Get a set of locations from each Region
@@ -171,22 +172,22 @@ void SimpleSimulation::generateAgents(int num, bool birth, std::string type) {
 
         // Randomly sample the four locations of interest for the agent
         if (homeLocations.size() > 0) {
-            homeLocation = homeLocations[rand() % homeLocations.size()];
+            homeLocation = homeLocations[getRandom() % homeLocations.size()];
         }
         if (schoolLocations.size() > 0) {
-            schoolLocation = schoolLocations[rand() % schoolLocations.size()];
+            schoolLocation = schoolLocations[getRandom() % schoolLocations.size()];
         }
         if (workLocations.size() > 0) {
-            workLocation = workLocations[rand() % workLocations.size()];
+            workLocation = workLocations[getRandom() % workLocations.size()];
         }
         if (leisureLocations.size() > 0) {
-            leisureLocation = leisureLocations[rand() % leisureLocations.size()];
+            leisureLocation = leisureLocations[getRandom() % leisureLocations.size()];
         }
 
         // Randomly sample an age assignment for the agent (update later)
         int ageAssignment = 0;
         if (!birth) {
-            ageAssignment = AgentController::sampleAgentAge();
+            ageAssignment = getController()->sampleAgentAge();
         }
 
         // Randomly sample a behavior assignment of the agent based on its age
@@ -242,6 +243,12 @@ void SimpleSimulation::generateAgents(int num, bool birth, std::string type) {
                               behaviorAssignment);
         }
 
+        // Give pandemic agents their health status from the Simulation's engine
+        PandemicAgent* pandemicAgent = dynamic_cast<PandemicAgent*>(agent);
+        if (pandemicAgent != nullptr) {
+            pandemicAgent->rollHealthStatus(getRandom());
+        }
+
         // If selected, set a unique color for each behavior
         if (checkDebug("visualize behaviors")) {
             agent->getGraphicsObject()->setPen(
@@ -1,6 +1,11 @@
 #include "Headers/Simulation.h"
 #include "Headers/EconomicController.h"
 
+#include <atomic>
+
+#include "QDir"
+#include "QDateTime"
+
 // Initialize the static members of the Simulation Class
 int Simulation::FRAMES_PER_HOUR = 20;
 
@@ -31,6 +36,10 @@ void Simulation::ageAgents() {
         }
     }
 
+    // Collect the new ages before the charts are told to update
+    agentLock.unlock();
+    collectStats();
+
     if (agentKilled) {
         emit updateChart("ALL", false);
     } else {
@@ -49,15 +58,19 @@ void Simulation::ageAgents() {
 
 
 Simulation::Simulation(int numAgents, Ui::MainWindow* ui,
-                       std::map<std::string, bool> debug) {
+                       std::map<std::string, bool> debug,
+                       const SimulationSettings* settings) {
 
-    // Initialize main components of the UI
+    // Initialize main components of the UI. A Simulation without a UI reads
+    // its settings from the ones it was given
     assert(numAgents >= 0);
+    assert(ui != nullptr || settings != nullptr);
     this->initialNumAgents = numAgents;
     this->agents.reserve(numAgents);
     this->ui = ui;
-    this->simHeight = ui->mainCanvas->height();
-    this->simWidth = ui->mainCanvas->width();
+    this->settings = (ui != nullptr) ? MainWindow::readSettings(ui) : *settings;
+    this->simHeight = this->settings.canvasHeight;
+    this->simWidth = this->settings.canvasWidth;
     this->isReset = false;
 
     // Read in the debug information
@@ -67,6 +80,8 @@ Simulation::Simulation(int numAgents, Ui::MainWindow* ui,
     this->year = 0;
     this->day = 0;
     this->hour = 0;
+    this->numFrames = 0;
+    this->firstFrame = true;
 
     // Create an AgentController for the Simulation
     this->agentController = new AgentController(this);
@@ -81,12 +96,39 @@ Simulation::Simulation(int numAgents, Ui::MainWindow* ui,
     agentLock = new QMutex();
     locationLock = new QMutex();
     queueLock = new QMutex();
+    dirtyLock = new QMutex();
+    statsLock = new QMutex();
+
+    // No statistics are available until the Agents have been generated
+    this->statsCollected = false;
 
     // Update the population counter
-    ui->currentPopulation->setText(QString::number(initialNumAgents));
+    if (ui != nullptr) {
+        ui->currentPopulation->setText(QString::number(initialNumAgents));
+    }
 
     // Default initialize the homeless shelter
     this->homelessShelter = nullptr;
+
+    // Seed the random engine from rand() so runs without an explicit seed
+    // behave as before
+    this->randomEngine.seed(static_cast<unsigned int>(rand()));
+
+    // Open a new event log for this Simulation if one was requested
+    this->eventLog = nullptr;
+    if (checkDebug("event log")) {
+        static std::atomic<int> logCounter(0);
+        QString dirname = QString("%1/events").arg(QDir::currentPath());
+        QString filename = QString("%1/%2_%3.evt").arg(dirname)
+                .arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"))
+                .arg(logCounter++);
+        QDir().mkpath(dirname);
+        eventLog = new EventLog(filename);
+        if (!eventLog->isOpen()) {
+            delete eventLog;
+            eventLog = nullptr;
+        }
+    }
 }
 
 
@@ -95,9 +137,11 @@ Simulation::Simulation(int numAgents, Ui::MainWindow* ui,
 
 Simulation::~Simulation() {
     // Remove any memory traces from the chartViews
-    ui->graphView1->setChart(new QtCharts::QChart());
-    ui->graphView2->setChart(new QtCharts::QChart());
-    ui->graphView3->setChart(new QtCharts::QChart());
+    if (ui != nullptr) {
+        ui->graphView1->setChart(new QtCharts::QChart());
+        ui->graphView2->setChart(new QtCharts::QChart());
+        ui->graphView3->setChart(new QtCharts::QChart());
+    }
 
     while (agents.size() > 0) {
         Agent* victim = agents.back();
@@ -112,6 +156,11 @@ Simulation::~Simulation() {
     delete destinationHelper;
 
     delete agentLock;
+    delete dirtyLock;
+    delete statsLock;
+
+    // Write out any events still sitting in a buffer
+    delete eventLog;
 }
 
 
@@ -119,6 +168,9 @@ Simulation::~Simulation() {
 
 
 int Simulation::getNumLocations() {
+    if (ui == nullptr) {
+        return settings.numLocations;
+    }
     return ui->numLocations->value();
 }
 
@@ -126,11 +178,34 @@ int Simulation::getNumLocations() {
 //******************************************************************************
 
 
+int Simulation::getHospitalCapacity() {
+    if (ui == nullptr) {
+        return settings.hospitalCapacity;
+    }
+    return ui->hospitalCapacity->value();
+}
+
+
+//******************************************************************************
+
+
+bool Simulation::isHeadless() {
+    return ui == nullptr || ui->headlessMode->checkState() == Qt::CheckState::Checked;
+}
+
+
+//******************************************************************************
+
+
 void Simulation::addAgent(Agent *agent) {
     // Add a new agent to the simulation and add it to the screen
     if (this->agents.size() < static_cast<size_t>(2 * this->initialNumAgents)) {
         this->agents.push_back(agent);
         addToAddQueue(agent->getGraphicsObject());
+
+        // Ensure the new agent is colored on the next frame
+        agent->setSimulation(this);
+        agent->markDirty();
     }
 }
 
@@ -147,6 +222,10 @@ std::vector<Agent*>& Simulation::getAgents() {
 
 
 void Simulation::addToScreen(QGraphicsItem *item) {
+    if (ui == nullptr) {
+        headlessItems.insert(item);
+        return;
+    }
     ui->mainCanvas->scene()->addItem(item);
 }
 
@@ -156,9 +235,6 @@ void Simulation::addToScreen(QGraphicsItem *item) {
 
 void Simulation::advanceTime() {
     // Increment the time by one frame
-    static int numFrames = 0;
-    static bool firstFrame = true;
-
     // Always force the Agent Update to run on the first frame
     if (firstFrame) {
         agentController->updateAgentDestinations(getAgents(), this->hour);
@@ -169,33 +245,37 @@ void Simulation::advanceTime() {
         // Increment the number of hours
         numFrames = 0;
         this->hour++;
-        ui->hour->setText(QString::number(this->hour));
 
         if (this->hour == 24) {
             // Increment the number of days
             this->hour = 0;
-            ui->hour->setText(QString::number(this->hour));
             this->day++;
-            ui->day->setText(QString::number(this->day));
-            ui->currentPopulation->setText(QString::number(getCurrentNumAgents())); // Update the population counter
 
             if (this->day == 365) {
                 // Increment the number of years
                 this->day = 0;
                 ageAgents(); // Update the age for every agent in the sim
-                ui->day->setText(QString::number(this->day));
                 this->year++;
-                ui->year->setText(QString::number(this->year));
             }
         }
 
+        // Update the clock on the screen
+        if (ui != nullptr) {
+            ui->hour->setText(QString::number(this->hour));
+            ui->day->setText(QString::number(this->day));
+            ui->year->setText(QString::number(this->year));
+        }
+
         // Update each agent's destination assignment each hour
         agentController->updateAgentDestinations(getAgents(), this->hour);
+        collectStats();
         emit updateChart("DESTINATION", false);
     }
 
     // Update the population counter
-    ui->currentPopulation->setText(QString::number(getCurrentNumAgents()));
+    if (ui != nullptr) {
+        ui->currentPopulation->setText(QString::number(getCurrentNumAgents()));
+    }
 
     // Increment the frame counter
     numFrames++;
@@ -206,8 +286,51 @@ void Simulation::advanceTime() {
 
 
 
+void Simulation::skipToEndOfHour() {
+    numFrames = FRAMES_PER_HOUR;
+}
+
+
+//******************************************************************************
+
+
+
 void Simulation::killAgent(Agent *victim, int index) {
 
+    // Remove the agent from the vector of agents held in the simulation
+    std::iter_swap(agents.begin() + index, agents.begin() + agents.size() - 1);
+    agents.pop_back();
+
+    releaseAgent(victim);
+}
+
+
+//******************************************************************************
+
+
+void Simulation::killAgents(const std::vector<int> &indices) {
+    if (indices.empty()) {
+        return;
+    }
+
+    // Release every victim, leaving a hole in the agents vector
+    for (size_t i = 0; i < indices.size(); ++i) {
+        releaseAgent(agents[indices[i]]);
+        agents[indices[i]] = nullptr;
+    }
+
+    // Close the holes in a single pass
+    agents.erase(std::remove(agents.begin(), agents.end(), nullptr), agents.end());
+}
+
+
+//******************************************************************************
+
+
+void Simulation::releaseAgent(Agent *victim) {
+
+    logEvent(EventLog::DEATH, victim->getID());
+
     // Remove the agent from each Location it belongs to
     if (victim->getLocation(Agent::HOME)) {
         victim->getLocation(Agent::HOME)->removeAgent(victim);
@@ -224,10 +347,10 @@ void Simulation::killAgent(Agent *victim, int index) {
 
     // Remove the Agent from the Screen
     addToRemoveQueue(victim->getGraphicsObject());
+    unmarkDirty(victim);
 
-    // Remove the agent from the vector of agents held in the simulation
-    std::iter_swap(agents.begin() + index, agents.begin() + agents.size() - 1);
-    agents.pop_back();
+    // Let the controller drop anything it holds for the Agent
+    agentController->removeAgent(victim);
 
     // Delete the agent
     delete victim;
@@ -238,7 +361,7 @@ void Simulation::killAgent(Agent *victim, int index) {
 
 
 void Simulation::birthAgent() {
-    if (rand() % 100 == 0) {
+    if (getRandom() % 100 == 0) {
         generateAgents(1, true);
     }
 }
@@ -248,6 +371,13 @@ void Simulation::birthAgent() {
 
 
 void Simulation::clearScreen() {
+    if (ui == nullptr) {
+        for (auto it = headlessItems.begin(); it != headlessItems.end(); ++it) {
+            delete *it;
+        }
+        headlessItems.clear();
+        return;
+    }
     ui->mainCanvas->scene()->clear();
 }
 
@@ -257,6 +387,10 @@ void Simulation::clearScreen() {
 
 void Simulation::clearAgents() {
     agents.clear();
+
+    QMutexLocker lock(dirtyLock);
+    dirtyAgents.clear();
+    dirtyLocations.clear();
 }
 
 
@@ -347,6 +481,26 @@ void Simulation::mapChartViews() {
         {2, "DESTINATION"}
     };
 
+    // Delete the existing map to overwrite it
+    delete this->chartViews;
+    this->chartViews = new std::unordered_map<QString, int>;
+
+    // Initialize vectors for each key
+    (*chartViews)["AGE"] = -1;
+    (*chartViews)["BEHAVIOR"] = -1;
+    (*chartViews)["DESTINATION"] = -1;
+    (*chartViews)["AGENT VALUE"] = -1;
+    (*chartViews)["ECONOMIC STATUS"] = -1;
+    (*chartViews)["BUSINESS VALUE"] = -1;
+    (*chartViews)["TOTAL VALUE"] = -1;
+    (*chartViews)["SEIR"] = -1;
+    (*chartViews)["DAILY TRACKER"] = -1;
+
+    // A Simulation without a UI has no charts to show
+    if (ui == nullptr) {
+        return;
+    }
+
     if (ui->simulationType->currentText() == "Economic Simulation") {
         indexMap[3] = "AGENT VALUE";
         indexMap[4] = "ECONOMIC STATUS";
@@ -364,21 +518,6 @@ void Simulation::mapChartViews() {
         indexMap[8] = "DAILY TRACKER";
     }
 
-    // Delete the existing map to overwrite it
-    delete this->chartViews;
-    this->chartViews = new std::unordered_map<QString, int>;
-
-    // Initialize vectors for each key
-    (*chartViews)["AGE"] = -1;
-    (*chartViews)["BEHAVIOR"] = -1;
-    (*chartViews)["DESTINATION"] = -1;
-    (*chartViews)["AGENT VALUE"] = -1;
-    (*chartViews)["ECONOMIC STATUS"] = -1;
-    (*chartViews)["BUSINESS VALUE"] = -1;
-    (*chartViews)["TOTAL VALUE"] = -1;
-    (*chartViews)["SEIR"] = -1;
-    (*chartViews)["DAILY TRACKER"] = -1;
-
     QString graph = indexMap[ui->graph1Selection->currentIndex()];
     (*chartViews)[graph] = 0;
 
@@ -408,29 +547,29 @@ void Simulation::renderChartUpdates(QString which, bool newChartView) {
         return;
     }
 
+    // Read the counts from the most recent statistics rather than the Agents
+    SimulationStats stats = getStats();
+
     if (which == "AGE") {
         if (newChartView) {
-            QtCharts::QChart* chart = ageHelper->getChart(&getAgents());
+            QtCharts::QChart* chart = ageHelper->getChart(stats);
             addChartToView(chart, graphView);
         } else {
-            ageHelper->updateChart(&getAgents());
+            ageHelper->updateChart(stats);
         }
     } else if (which == "BEHAVIOR") {
-        int numAdultBehaviors = getController()->getNumAdultBehaviors();
-        int numChildBehaviors = getController()->getNumChildBehaviors();
-
         if (newChartView) {
-            QtCharts::QChart* chart = behaviorHelper->getChart(&getAgents(), numAdultBehaviors, numChildBehaviors);
+            QtCharts::QChart* chart = behaviorHelper->getChart(stats);
             addChartToView(chart, graphView);
         } else {
-            behaviorHelper->updateChart(&getAgents(), numAdultBehaviors, numChildBehaviors);
+            behaviorHelper->updateChart(stats);
         }
     } else if (which == "DESTINATION") {
         if (newChartView) {
-            QtCharts::QChart* chart = destinationHelper->getChart(&getAgents());
+            QtCharts::QChart* chart = destinationHelper->getChart(stats);
             addChartToView(chart, graphView);
         } else {
-            destinationHelper->updateChart(&getAgents());
+            destinationHelper->updateChart(stats);
         }
     }
 }
@@ -465,6 +604,10 @@ QMutex* Simulation::getQueueLock() {
 
 void Simulation::addToAddQueue(QGraphicsItem *item) {
     QMutexLocker lock(getQueueLock());
+    if (ui == nullptr) {
+        headlessItems.insert(item);
+        return;
+    }
     addQueue.push_back(item);
 }
 
@@ -472,8 +615,25 @@ void Simulation::addToAddQueue(QGraphicsItem *item) {
 //******************************************************************************
 
 
+void Simulation::addToAddQueue(const QVector<QGraphicsItem*> &items) {
+    QMutexLocker lock(getQueueLock());
+    if (ui == nullptr) {
+        headlessItems.insert(items.begin(), items.end());
+        return;
+    }
+    addQueue.append(items);
+}
+
+
+//******************************************************************************
+
+
 void Simulation::addToRemoveQueue(QGraphicsItem *item) {
     QMutexLocker lock(getQueueLock());
+    if (ui == nullptr) {
+        headlessItems.erase(item);
+        return;
+    }
     removeQueue.push_back(item);
 }
 
@@ -481,6 +641,187 @@ void Simulation::addToRemoveQueue(QGraphicsItem *item) {
 //******************************************************************************
 
 
+void Simulation::addToRemoveQueue(const QVector<QGraphicsItem*> &items) {
+    QMutexLocker lock(getQueueLock());
+    if (ui == nullptr) {
+        for (int i = 0; i < items.size(); ++i) {
+            headlessItems.erase(items[i]);
+        }
+        return;
+    }
+    removeQueue.append(items);
+}
+
+
+//******************************************************************************
+
+
+void Simulation::markDirty(Agent* agent) {
+    QMutexLocker lock(dirtyLock);
+    dirtyAgents.insert(agent);
+}
+
+
+//******************************************************************************
+
+
+void Simulation::markDirty(Location* location) {
+    QMutexLocker lock(dirtyLock);
+    dirtyLocations.insert(location);
+}
+
+
+//******************************************************************************
+
+
+void Simulation::unmarkDirty(Agent* agent) {
+    QMutexLocker lock(dirtyLock);
+    dirtyAgents.erase(agent);
+}
+
+
+//******************************************************************************
+
+
+void Simulation::unmarkDirty(Location* location) {
+    QMutexLocker lock(dirtyLock);
+    dirtyLocations.erase(location);
+}
+
+
+//******************************************************************************
+
+
+void Simulation::logEvent(EventLog::TYPE type, int agentID, int locationID, long long amount) {
+    if (eventLog == nullptr) {
+        return;
+    }
+    int totalHours = (year * 365 + day) * 24 + hour;
+    eventLog->record(type, totalHours, agentID, locationID, amount);
+}
+
+
+//******************************************************************************
+
+
+void Simulation::seedRandom(unsigned int seed) {
+    randomEngine.seed(seed);
+}
+
+
+//******************************************************************************
+
+
+int Simulation::getRandom() {
+    // Drop the low bit so the result always fits in a non-negative int
+    return static_cast<int>(randomEngine() >> 1);
+}
+
+
+//******************************************************************************
+
+
+std::vector<Agent*> Simulation::takeDirtyAgents() {
+    QMutexLocker lock(dirtyLock);
+    std::vector<Agent*> dirty(dirtyAgents.begin(), dirtyAgents.end());
+    dirtyAgents.clear();
+    return dirty;
+}
+
+
+//******************************************************************************
+
+
+std::vector<Location*> Simulation::takeDirtyLocations() {
+    QMutexLocker lock(dirtyLock);
+    std::vector<Location*> dirty(dirtyLocations.begin(), dirtyLocations.end());
+    dirtyLocations.clear();
+    return dirty;
+}
+
+
+//******************************************************************************
+
+
+void Simulation::collectStats() {
+    SimulationStats newStats(agentController->getNumAdultBehaviors(),
+                             agentController->getNumChildBehaviors());
+
+    // Tally every statistic in a single pass over the Agents
+    QMutexLocker agentLock(getAgentsLock());
+    newStats.numAgents = static_cast<int>(agents.size());
+    for (size_t i = 0; i < agents.size(); ++i) {
+        collectAgentStats(agents[i], newStats);
+    }
+    agentLock.unlock();
+
+    // Tally the statistics that depend on the Locations
+    QMutexLocker locationLock(getLocationLock());
+    collectLocationStats(newStats);
+    locationLock.unlock();
+
+    // Publish the new statistics for the chart helpers
+    QMutexLocker lock(statsLock);
+    std::swap(stats, newStats);
+    statsCollected = true;
+}
+
+
+//******************************************************************************
+
+
+SimulationStats Simulation::getStats() {
+    QMutexLocker lock(statsLock);
+
+    // Collect an initial set of statistics if the worker hasn't yet
+    if (!statsCollected) {
+        lock.unlock();
+        collectStats();
+        lock.relock();
+    }
+
+    return stats;
+}
+
+
+//******************************************************************************
+
+
+void Simulation::collectAgentStats(Agent* agent, SimulationStats &stats) {
+    // Count the Agent in its age bucket
+    int ageBucket = std::min(agent->getAge() / 10, SimulationStats::NUM_AGE_BUCKETS - 1);
+    stats.ageCounts[ageBucket]++;
+
+    // Count the Agent's behavior chart
+    std::vector<int>& behaviorCounts = agent->isAdult() ? stats.adultBehaviorCounts :
+                                                          stats.childBehaviorCounts;
+    if (agent->getBehavior() < static_cast<int>(behaviorCounts.size())) {
+        behaviorCounts[agent->getBehavior()]++;
+    }
+
+    // Count the Agent's current destination
+    QString destination = agent->getDestinationString();
+    if (destination == "Home") {
+        stats.destinationCounts[Agent::HOME]++;
+    } else if (destination == "Work") {
+        stats.destinationCounts[Agent::WORK]++;
+    } else if (destination == "School") {
+        stats.destinationCounts[Agent::SCHOOL]++;
+    } else if (destination == "Leisure") {
+        stats.destinationCounts[Agent::LEISURE]++;
+    }
+}
+
+
+//******************************************************************************
+
+
+void Simulation::collectLocationStats(SimulationStats&) {}
+
+
+//******************************************************************************
+
+
 Ui::MainWindow* Simulation::getUI() {
     return ui;
 }
@@ -560,6 +901,10 @@ Location* Simulation::getHomelessShelter() {
 
 
 void Simulation::updateDebug() {
+    // A Simulation without a UI keeps the debug info it was created with
+    if (ui == nullptr) {
+        return;
+    }
     this->debug = MainWindow::checkDebugInfo(ui);
 }
 
@@ -53,7 +53,9 @@ void SimulationWorker::startThread(const QString &) {
             &SimulationWorker::executeSimTimestep);
 
     // Set the timeout milliseconds based on the simulation speed
-    if (this->frameRate == UNLIMITED) {
+    if (this->frameRate == TURBO) {
+        executeLoop->start(0); // Fire whenever the event loop is idle
+    } else if (this->frameRate == UNLIMITED) {
         if (sim->checkDebug("headless mode")) {
             executeLoop->start(2);
         } else {
@@ -75,8 +77,18 @@ void SimulationWorker::startThread(const QString &) {
 void SimulationWorker::executeSimTimestep() {
     // Execute timesetp and inform screen to update rendering
     if (continueSimulation) {
-        sim->execute();
-        emit timestepComplete("Done");
+        QElapsedTimer budget;
+        budget.start();
+        if (this->frameRate == TURBO) {
+            // Execute timesteps back to back until the budget is spent, then
+            // yield so pause and speed requests can be handled
+            do {
+                sim->execute();
+            } while (continueSimulation && budget.elapsed() < TURBO_BUDGET);
+        } else {
+            sim->execute();
+        }
+        emit timestepComplete("Done", budget.nsecsElapsed() / 1.0e6);
     } else {
         // Otherwise stop the timer and wait
         executeLoop->stop();
@@ -90,7 +102,8 @@ void SimulationWorker::executeSimTimestep() {
 
 
 SimulationController::SimulationController(Simulation* sim,
-                                           SimulationWorker::Speed frameRate) {
+                                           SimulationWorker::Speed frameRate,
+                                           int targetFPS) {
 
     // Create a new simulation worker
     worker = new SimulationWorker(sim, frameRate);
@@ -99,6 +112,12 @@ SimulationController::SimulationController(Simulation* sim,
     // Initialize the speed of the Simulation
     this->currentSpeed = frameRate;
 
+    // Initialize the render pacing, no render has been measured yet
+    this->targetFPS = std::max(targetFPS, 1);
+    this->nextFrame = 0;
+    this->averageRenderTime = 0;
+    this->stepTimeSinceRender = 0;
+
     // Move the worker object onto a second thread
     worker->moveToThread(&workerThread);
 
@@ -171,33 +190,67 @@ void SimulationController::changeSpeed(SimulationWorker::Speed newSpeed) {
 //******************************************************************************
 
 
-void SimulationController::updateScreen(const QString &) {
-    static int i = 0;
+void SimulationController::setTargetFPS(int targetFPS) {
+    this->targetFPS = std::max(targetFPS, 1);
+}
 
-    // Render every third frame at 60 FPS
-    if (currentSpeed == SimulationWorker::FAST) {
-        if (i < 2) {
-            i++;
-            return;
-        } else {
-            i = 0;
-        }
+
+//******************************************************************************
+
+
+void SimulationController::updateScreen(const QString &, double stepTime) {
+
+    // Headless simulations are never rendered
+    if (sim->checkDebug("headless mode")) {
+        return;
+    }
+
+    stepTimeSinceRender += stepTime;
+
+    // Wait until the next frame is due at the target frame rate. The worker's
+    // timer ticks in whole milliseconds, so a tick within a quarter of a frame
+    // of the schedule still renders rather than waiting for the next tick
+    qint64 frameInterval = 1000000000LL / targetFPS;
+    bool firstFrame = !frameClock.isValid();
+    qint64 frameStart = firstFrame ? 0 : frameClock.nsecsElapsed();
+    if (!firstFrame && frameStart < nextFrame - frameInterval / 4) {
+        return;
     }
 
-    // Render every 10th frame at Unlimited FPS
-    if (currentSpeed == SimulationWorker::UNLIMITED) {
-        if (i < 10) {
-            i++;
+    // When the Simulation runs as fast as possible, rendering competes with it
+    // for the Agents, so cap the share of time spent rendering
+    if (currentSpeed == SimulationWorker::UNLIMITED ||
+            currentSpeed == SimulationWorker::TURBO) {
+        double minStepTime = averageRenderTime * (1 - MAX_RENDER_SHARE) / MAX_RENDER_SHARE;
+        if (stepTimeSinceRender < minStepTime) {
             return;
-        } else {
-            i = 0;
         }
     }
 
-    if (!sim->checkDebug("headless mode")) {
-        sim->renderAgentUpdate();
+    // Schedule the next frame from the start of this one, unless rendering
+    // has fallen more than a frame behind the schedule
+    if (firstFrame) {
+        frameClock.start();
+    }
+    nextFrame += frameInterval;
+    if (nextFrame < frameStart) {
+        nextFrame = frameStart + frameInterval;
     }
-    return;
+
+    // Render the screen and measure how long it took
+    QElapsedTimer renderTimer;
+    renderTimer.start();
+    sim->renderAgentUpdate();
+    double renderTime = renderTimer.nsecsElapsed() / 1.0e6;
+
+    if (firstFrame) {
+        averageRenderTime = renderTime;
+    } else {
+        averageRenderTime = (1 - RENDER_SMOOTHING) * averageRenderTime +
+                RENDER_SMOOTHING * renderTime;
+    }
+
+    stepTimeSinceRender = 0;
 }
 
 
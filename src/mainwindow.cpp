@@ -4,6 +4,7 @@
 #include "Headers/PandemicSimulation.h"
 #include "Headers/DualSimulation.h"
 #include "Headers/TrainingExecution.h"
+#include "Headers/EnsembleExecution.h"
 #include "Headers/Network.h"
 
 MainWindow::MainWindow(QWidget *parent)
@@ -45,6 +46,7 @@ MainWindow::MainWindow(QWidget *parent)
     // Create a SimpleSimulation and connect it to the UI
     SimpleSimulation* simulation = new SimpleSimulation(50, ui, checkDebugInfo(ui));
     controller = nullptr;
+    ensembleRunner = nullptr;
     this->sim = simulation;
 
     // Initialize each of the Main Window's Combo Boxes
@@ -74,6 +76,7 @@ MainWindow::~MainWindow() {
     if (controller) {
         controller->pauseSimulation();
     }
+    delete ensembleRunner;
     delete sim;
     delete ui->graphView1->chart();
     delete ui->graphView2->chart();
@@ -99,6 +102,7 @@ void MainWindow::disableUI() {
     ui->numAgentsLabel->setEnabled(false);
     ui->agentBehaviors->setEnabled(false);
     ui->headlessMode->setEnabled(false);
+    ui->eventLog->setEnabled(false);
     ui->framesPerHour->setEnabled(false);
     ui->framesPerHourSlider->setEnabled(false);
 
@@ -136,6 +140,7 @@ void MainWindow::enableUI() {
     ui->numAgentsLabel->setEnabled(true);
     ui->agentBehaviors->setEnabled(true);
     ui->headlessMode->setEnabled(true);
+    ui->eventLog->setEnabled(true);
     ui->framesPerHour->setEnabled(true);
     ui->framesPerHourSlider->setEnabled(true);
 
@@ -274,6 +279,14 @@ void MainWindow::showPandemicOptions(bool show) {
     ui->hospitalCapacityLabel->setVisible(show);
     ui->hospitalCapacitySlider->setVisible(show);
 
+    ui->transmissionModelLabel->setVisible(show);
+    ui->transmissionModel->setVisible(show);
+    ui->fastForwardLag->setVisible(show);
+
+    ui->numReplicates->setVisible(show);
+    ui->ensembleDays->setVisible(show);
+    ui->runEnsemble->setVisible(show);
+
     ui->totalCaseLabel->setVisible(show);
     ui->totalCases->setVisible(show);
     ui->totalDeathsLabel->setVisible(show);
@@ -296,6 +309,14 @@ void MainWindow::enablePandemicOptions(bool enabled) {
     ui->hospitalCapacity->setEnabled(enabled);
     ui->hospitalCapacitySlider->setEnabled(enabled);
 
+    ui->transmissionModelLabel->setEnabled(enabled);
+    ui->transmissionModel->setEnabled(enabled);
+    ui->fastForwardLag->setEnabled(enabled);
+
+    ui->numReplicates->setEnabled(enabled);
+    ui->ensembleDays->setEnabled(enabled);
+    ui->runEnsemble->setEnabled(enabled);
+
     // Always keep groupBox enabled
     if (!enabled) {
         return;
@@ -494,6 +515,12 @@ void MainWindow::initializeComboBoxes() {
     coloringTypes.append("Economic Status");
     ui->agentColoring->addItems(coloringTypes);
 
+    // Define the values for the transmissionModel dropdown
+    QStringList transmissionTypes;
+    transmissionTypes.append("Radius Spread");
+    transmissionTypes.append("Location Contact");
+    ui->transmissionModel->addItems(transmissionTypes);
+
     QStringList policyTypes;
     policyTypes.append("Pandemic");
     policyTypes.append("Economic");
@@ -573,6 +600,8 @@ std::map<std::string, bool> MainWindow::checkDebugInfo(Ui::MainWindow* ui) {
                                     Qt::CheckState::Checked);
     debug["headless mode"] = (ui->headlessMode->checkState() ==
                               Qt::CheckState::Checked);
+    debug["event log"] = (ui->eventLog->checkState() ==
+                          Qt::CheckState::Checked);
 
     // Add debug information for the Pandemic Options
     debug["quarantine when infected"] = (ui->quarantineWhenInfected->checkState() ==
@@ -624,6 +653,12 @@ std::map<std::string, bool> MainWindow::checkDebugInfo(Ui::MainWindow* ui) {
     debug["pandemic agent coloring"] = (ui->agentColoring->currentText() ==
                                         "Pandemic Status");
 
+    debug["fast forward lag"] = (ui->fastForwardLag->checkState() ==
+                                 Qt::CheckState::Checked);
+
+    debug["location contact transmission"] = (ui->transmissionModel->currentText() ==
+                                              "Location Contact");
+
     return debug;
 }
 
@@ -631,6 +666,19 @@ std::map<std::string, bool> MainWindow::checkDebugInfo(Ui::MainWindow* ui) {
 //******************************************************************************
 
 
+SimulationSettings MainWindow::readSettings(Ui::MainWindow* ui) {
+    SimulationSettings settings;
+    settings.canvasWidth = ui->mainCanvas->width();
+    settings.canvasHeight = ui->mainCanvas->height();
+    settings.numLocations = ui->numLocations->value();
+    settings.hospitalCapacity = ui->hospitalCapacity->value();
+    return settings;
+}
+
+
+//******************************************************************************
+
+
 void MainWindow::on_runSimulation_clicked() {
     // Disable the UI and reset the simulation
     disableUI();
@@ -676,7 +724,8 @@ void MainWindow::on_runSimulation_clicked() {
 
     // Create a SimulationController and connect it to the Simulation
     SimulationController* control = new SimulationController(this->sim,
-                                                             SimulationWorker::NORMAL);
+                                                             SimulationWorker::NORMAL,
+                                                             ui->displayFPS->value());
 
     // Connect the controller to the window and start the simulation
     this->paused = false;
@@ -760,10 +809,13 @@ void MainWindow::on_numAgentsLabel_valueChanged(int arg1) {
 
 void MainWindow::on_slowSim_clicked() {
     // Slow down the simulation based on the current state
-    if(currentSpeed == "Unlimited") {
+    if (currentSpeed == "Turbo") {
+        this->controller->changeSpeed(SimulationWorker::UNLIMITED);
+        this->currentSpeed = "Unlimited";
+        ui->fastSim->setEnabled(true); //Make user able to speed up sim again
+    } else if(currentSpeed == "Unlimited") {
         this->controller->changeSpeed(SimulationWorker::FAST);
         this->currentSpeed = "Fast";
-        ui->fastSim->setEnabled(true); //Make user able to speed up sim again
     } else if (currentSpeed == "Fast") {
         this->controller->changeSpeed(SimulationWorker::NORMAL);
         this->currentSpeed = "Normal";
@@ -789,7 +841,7 @@ void MainWindow::on_pauseSim_clicked() {
 
         // Re-enable speed buttons when the simulation is played
         ui->slowSim->setEnabled(currentSpeed != "Slow");
-        ui->fastSim->setEnabled(currentSpeed != "Unlimited");
+        ui->fastSim->setEnabled(currentSpeed != "Turbo");
     } else {
         // Stop the simulation and update the UI
         this->controller->pauseSimulation();
@@ -819,6 +871,9 @@ void MainWindow::on_fastSim_clicked() {
     } else if (currentSpeed == "Fast") {
         this->controller->changeSpeed(SimulationWorker::UNLIMITED);
         this->currentSpeed = "Unlimited";
+    } else if (currentSpeed == "Unlimited") {
+        this->controller->changeSpeed(SimulationWorker::TURBO);
+        this->currentSpeed = "Turbo";
         ui->fastSim->setEnabled(false);
     }
     ui->speed->setText(currentSpeed);
@@ -995,6 +1050,16 @@ void MainWindow::on_hospitalCapacity_valueChanged(int arg1) {
 //******************************************************************************
 
 
+void MainWindow::on_displayFPS_valueChanged(int arg1) {
+    if (controller) {
+        controller->setTargetFPS(arg1);
+    }
+}
+
+
+//******************************************************************************
+
+
 void MainWindow::on_hospitalCapacitySlider_valueChanged(int value) {
     ui->hospitalCapacity->setValue(value);
 }
@@ -1052,6 +1117,46 @@ void MainWindow::on_evaluateNetwork_clicked() {
 //******************************************************************************
 
 
+void MainWindow::on_runEnsemble_clicked() {
+    QString type = "Pandemic";
+    if (ui->simulationType->currentText() == "Dual Simulation") {
+        type = "Dual";
+    }
+
+    // Prevent the settings from changing while the replicates are created
+    ui->simulationType->setEnabled(false);
+    ui->runSimulation->setEnabled(false);
+    ui->framesPerHour->setEnabled(false);
+    ui->framesPerHourSlider->setEnabled(false);
+    if (type == "Dual") {
+        enableDualOptions(false);
+    } else {
+        enablePandemicOptions(false);
+    }
+
+    // Create the ensemble and start running it in the background
+    ensembleRunner = new EnsembleRunner(ui, type, ui->numReplicates->value(),
+                                        ui->ensembleDays->value(),
+                                        static_cast<unsigned int>(rand()));
+    connect(ensembleRunner, &EnsembleRunner::printMessage, this, &MainWindow::printMessage);
+    connect(ensembleRunner, &EnsembleRunner::ensembleFinished, this, &MainWindow::finishEnsemble);
+    ensembleRunner->startEnsemble();
+}
+
+
+//******************************************************************************
+
+
+void MainWindow::finishEnsemble(const QString &) {
+    ensembleRunner->deleteLater();
+    ensembleRunner = nullptr;
+    enableUI();
+}
+
+
+//******************************************************************************
+
+
 void MainWindow::printMessage(const QString& message) {
     qDebug() << message << endl;
 }
@@ -0,0 +1,18 @@
+QT       += core
+QT       += concurrent
+QT       -= gui
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+# Reads the binary event logs written by the Simulation's EventLog
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../src/Currency.cpp \
+    ../../src/EventLog.cpp
+
+HEADERS += \
+    ../../Headers/Currency.h \
+    ../../Headers/EventLog.h
@@ -0,0 +1,60 @@
+#include "Headers/EventLog.h"
+#include "Headers/Currency.h"
+
+#include <algorithm>
+
+#include <QCoreApplication>
+#include <QTextStream>
+
+/**
+ * Prints an event log written by the Simulation as CSV, sorted by hour. With
+ * --summary, prints the number of events of each type instead.
+ *
+ * Usage: EventLogReader <file.evt> [--summary]
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QStringList args = a.arguments();
+    if (args.size() < 2) {
+        err << "Usage: EventLogReader <file.evt> [--summary]\n";
+        return 1;
+    }
+
+    std::vector<EventLog::Record> records;
+    if (!EventLog::readLog(args[1], records)) {
+        err << "Unable to read event log " << args[1] << "\n";
+        return 1;
+    }
+
+    // Each thread writes its own buffer, so restore the order of events
+    std::stable_sort(records.begin(), records.end(),
+                     [](const EventLog::Record &a, const EventLog::Record &b) {
+        return a.hour < b.hour;
+    });
+
+    if (args.contains("--summary")) {
+        std::vector<long long> counts(EventLog::TYPE_MAX + 1, 0);
+        for (size_t i = 0; i < records.size(); ++i) {
+            counts[std::min<int>(records[i].type, EventLog::TYPE_MAX)]++;
+        }
+        for (int type = 0; type <= EventLog::TYPE_MAX; ++type) {
+            if (counts[type] > 0) {
+                out << EventLog::getTypeName(type) << "," << counts[type] << "\n";
+            }
+        }
+        return 0;
+    }
+
+    out << "hour,event,agent,location,amount\n";
+    for (size_t i = 0; i < records.size(); ++i) {
+        const EventLog::Record &record = records[i];
+        out << record.hour << "," << EventLog::getTypeName(record.type) << ","
+            << record.agentID << "," << record.locationID << ","
+            << QString::number(Currency::fromUnits(record.amount).toDouble(), 'f', 4) << "\n";
+    }
+    return 0;
+}